@@ -12,6 +12,20 @@ generation_table = {
     'std::optional': {
         'prologue': '#include <optional>',
         'class_name': 'std::optional'
+    },
+    'opt::option module': {
+        'prologue': 'import opt.option;',
+        'class_name': 'opt::option'
+    },
+    'opt::option enum': {
+        'prologue': '#include <opt/option.hpp>',
+        'class_name': 'opt::option',
+        'enum': 'reflection'
+    },
+    'opt::option enum traits': {
+        'prologue': '#include <opt/option.hpp>',
+        'class_name': 'opt::option',
+        'enum': 'traits'
     }
 }
 
@@ -22,9 +36,19 @@ if gen_info is None:
 
 prologue = gen_info['prologue']
 class_name = gen_info['class_name']
+enum_mode = gen_info.get('enum')
 
 with open(output_path, 'w') as output_file:
     output_file.write(prologue + '\n')
     for i in range(iterations_number):
-        output_file.write(f'struct S{i} {{ int x; }};\n')
-        output_file.write(f'{class_name}<S{i}> b{i};\n')
+        if enum_mode is None:
+            output_file.write(f'struct S{i} {{ int x; }};\n')
+            output_file.write(f'{class_name}<S{i}> b{i};\n')
+        else:
+            # Unsigned enumerations of different sizes with a few enumerators
+            underlying = ['unsigned char', 'unsigned short', 'unsigned int', 'unsigned long long'][i % 4]
+            enumerators = ', '.join(f'e{j}' for j in range(3 + i % 17))
+            output_file.write(f'enum class E{i} : {underlying} {{ {enumerators} }};\n')
+            if enum_mode == 'traits':
+                output_file.write(f'template<> struct opt::enumeration_option_traits<E{i}> {{ static constexpr E{i} max_value = E{i}::e{2 + i % 17}; }};\n')
+            output_file.write(f'{class_name}<E{i}> b{i};\n')
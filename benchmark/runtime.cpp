@@ -0,0 +1,361 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+// Runtime benchmark of `opt::option` against `std::optional`.
+// Usage: option-bench-runtime [rounds]
+
+#include <opt/option.hpp>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <array>
+#include <tuple>
+#include <complex>
+#include <functional>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+#if OPTION_MSVC
+    #include <intrin.h>
+#endif
+
+namespace {
+
+#if OPTION_GCC || OPTION_CLANG
+template<class T>
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+inline void clobber_memory() {
+    asm volatile("" : : : "memory");
+}
+#else
+const void* volatile sink = nullptr;
+
+template<class T>
+inline void do_not_optimize(const T& value) {
+    sink = &value;
+    _ReadWriteBarrier();
+}
+inline void clobber_memory() {
+    _ReadWriteBarrier();
+}
+#endif
+
+constexpr std::size_t element_count = 1024;
+constexpr int samples = 5;
+std::size_t rounds = 200;
+
+template<class T, class = void>
+inline constexpr bool is_equality_comparable = false;
+template<class T>
+inline constexpr bool is_equality_comparable<T, decltype(void(std::declval<const T&>() == std::declval<const T&>()))> = true;
+
+// Unifies the `opt::option` and `std::optional` interfaces, so the same benchmark code is used for both
+template<class T>
+struct opt_api {
+    using type = opt::option<T>;
+    template<class U>
+    using rebind = opt::option<U>;
+
+    static type empty() { return opt::none; }
+
+    template<class U, class Fn>
+    static auto map(const opt::option<U>& x, Fn&& fn) { return x.map(fn); }
+    template<class U, class Fn>
+    static auto and_then(const opt::option<U>& x, Fn&& fn) { return x.and_then(fn); }
+};
+template<class T>
+struct std_api {
+    using type = std::optional<T>;
+    template<class U>
+    using rebind = std::optional<U>;
+
+    static type empty() { return std::nullopt; }
+
+    template<class U, class Fn>
+    static auto map(const std::optional<U>& x, Fn&& fn) {
+        using result = std::optional<std::invoke_result_t<Fn&, const U&>>;
+        return x.has_value() ? result{fn(*x)} : result{};
+    }
+    template<class U, class Fn>
+    static auto and_then(const std::optional<U>& x, Fn&& fn) {
+        using result = std::invoke_result_t<Fn&, const U&>;
+        return x.has_value() ? fn(*x) : result{};
+    }
+};
+
+template<class Fn>
+double measure(Fn&& fn) {
+    using clock = std::chrono::steady_clock;
+
+    double best = 0;
+    for (int sample = 0; sample < samples; ++sample) {
+        const auto start = clock::now();
+        for (std::size_t round = 0; round < rounds; ++round) {
+            fn();
+            clobber_memory();
+        }
+        const auto end = clock::now();
+
+        const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count());
+        const double ns_per_op = ns / double(rounds * element_count);
+        if (sample == 0 || ns_per_op < best) {
+            best = ns_per_op;
+        }
+    }
+    return best;
+}
+
+// Calls `setup` before each round (for operations that modify their input), the time of `setup` is not measured
+template<class Fn, class Setup>
+double measure(Fn&& fn, Setup&& setup) {
+    using clock = std::chrono::steady_clock;
+
+    double best = 0;
+    for (int sample = 0; sample < samples; ++sample) {
+        clock::duration elapsed{};
+        for (std::size_t round = 0; round < rounds; ++round) {
+            setup();
+            clobber_memory();
+            const auto start = clock::now();
+            fn();
+            clobber_memory();
+            elapsed += clock::now() - start;
+        }
+
+        const double ns = double(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        const double ns_per_op = ns / double(rounds * element_count);
+        if (sample == 0 || ns_per_op < best) {
+            best = ns_per_op;
+        }
+    }
+    return best;
+}
+
+enum class operation {
+    construct,
+    assign,
+    has_value,
+    get,
+    value_or,
+    map_and_then,
+    swap,
+    reset,
+    compare,
+    count_
+};
+constexpr const char* operation_names[]{
+    "construct", "assign", "has_value", "get", "value_or", "map/and_then", "swap", "reset", "compare"
+};
+constexpr std::size_t operation_count = std::size_t(operation::count_);
+
+template<class Api, class T, class Make>
+double run_operation(const operation op, Make& make) {
+    using option = typename Api::type;
+
+    std::vector<T> values;
+    values.reserve(element_count);
+    for (std::size_t i = 0; i < element_count; ++i) {
+        values.push_back(make(i));
+    }
+    std::vector<option> a;
+    std::vector<option> b;
+    a.reserve(element_count);
+    b.reserve(element_count);
+    const auto fill = [&] {
+        a.clear();
+        b.clear();
+        for (std::size_t i = 0; i < element_count; ++i) {
+            // Every 4th element is empty
+            if (i % 4 == 3) {
+                a.push_back(Api::empty());
+            } else {
+                a.emplace_back(make(i));
+            }
+            if (i % 4 == 1) {
+                b.push_back(Api::empty());
+            } else {
+                b.emplace_back(make(i + 1));
+            }
+        }
+    };
+    fill();
+
+    switch (op) {
+    case operation::construct:
+        return measure([&] {
+            for (std::size_t i = 0; i < element_count; ++i) {
+                if constexpr (std::is_copy_constructible_v<T>) {
+                    const option x{values[i]};
+                    do_not_optimize(x);
+                } else {
+                    const option x{make(i)};
+                    do_not_optimize(x);
+                }
+            }
+        });
+    case operation::assign:
+        return measure([&] {
+            for (std::size_t i = 0; i < element_count; ++i) {
+                if constexpr (std::is_copy_assignable_v<option>) {
+                    a[i] = b[i];
+                } else {
+                    a[i] = std::move(b[i]);
+                }
+            }
+            do_not_optimize(a[0]);
+        }, fill);
+    case operation::has_value:
+        return measure([&] {
+            std::size_t count = 0;
+            for (std::size_t i = 0; i < element_count; ++i) {
+                count += std::size_t(a[i].has_value());
+            }
+            do_not_optimize(count);
+        });
+    case operation::get:
+        return measure([&] {
+            for (std::size_t i = 0; i < element_count; ++i) {
+                if (a[i].has_value()) {
+                    do_not_optimize(*a[i]);
+                }
+            }
+        });
+    case operation::value_or:
+        return measure([&] {
+            for (std::size_t i = 0; i < element_count; ++i) {
+                if constexpr (std::is_copy_constructible_v<T>) {
+                    const T x = a[i].value_or(values[i]);
+                    do_not_optimize(x);
+                } else {
+                    do_not_optimize(a[i].has_value() ? *a[i] : values[i]);
+                }
+            }
+        });
+    case operation::map_and_then:
+        return measure([&] {
+            for (std::size_t i = 0; i < element_count; ++i) {
+                const auto x = Api::and_then(a[i], [&](const T& value) {
+                    using result = typename Api::template rebind<int>;
+                    do_not_optimize(value);
+                    return (i % 2 == 0) ? result{int(i)} : result{};
+                });
+                const auto y = Api::map(x, [](const int value) { return value + 1; });
+                do_not_optimize(y);
+            }
+        });
+    case operation::swap:
+        return measure([&] {
+            for (std::size_t i = 0; i < element_count; ++i) {
+                using std::swap;
+                swap(a[i], b[i]);
+            }
+            do_not_optimize(a[0]);
+        });
+    case operation::reset:
+        return measure([&] {
+            for (std::size_t i = 0; i < element_count; ++i) {
+                a[i].reset();
+            }
+            do_not_optimize(a[0]);
+        }, fill);
+    case operation::compare:
+        if constexpr (is_equality_comparable<T>) {
+            return measure([&] {
+                std::size_t count = 0;
+                for (std::size_t i = 0; i < element_count; ++i) {
+                    count += std::size_t(a[i] == b[i]);
+                }
+                do_not_optimize(count);
+            });
+        } else {
+            return -1;
+        }
+    case operation::count_:
+        break;
+    }
+    return -1;
+}
+
+template<class T, class Make>
+void run(const char* const strategy, const char* const type_name, Make make) {
+    std::printf("\n%s (%s)\n", type_name, strategy);
+    std::printf("  bytes/element: opt::option = %zu, std::optional = %zu\n", sizeof(opt::option<T>), sizeof(std::optional<T>));
+    std::printf("  %-14s %14s %16s %8s\n", "operation", "opt::option", "std::optional", "ratio");
+
+    for (std::size_t i = 0; i < operation_count; ++i) {
+        const auto op = operation(i);
+        const double opt_ns = run_operation<opt_api<T>, T>(op, make);
+        const double std_ns = run_operation<std_api<T>, T>(op, make);
+        if (opt_ns < 0 || std_ns < 0) {
+            std::printf("  %-14s %14s %16s %8s\n", operation_names[i], "-", "-", "-");
+        } else {
+            std::printf("  %-14s %11.3f ns %13.3f ns %8.2f\n", operation_names[i], opt_ns, std_ns, std_ns > 0 ? opt_ns / std_ns : 0.0);
+        }
+    }
+}
+
+enum class color : unsigned { red, green, blue, SENTINEL };
+
+struct polymorphic {
+    int value;
+    explicit polymorphic(const int value_) noexcept : value{value_} {}
+    virtual ~polymorphic() = default;
+    polymorphic(const polymorphic&) = default;
+    polymorphic& operator=(const polymorphic&) = default;
+    virtual int get() const noexcept { return value; }
+
+    friend bool operator==(const polymorphic& left, const polymorphic& right) noexcept {
+        return left.value == right.value;
+    }
+};
+
+struct member_struct {
+    int a;
+    int b;
+};
+
+int storage[element_count + 1]{};
+
+}
+
+int main(int argc, char** argv) {
+    if (argc > 1) {
+        rounds = std::size_t(std::strtoull(argv[1], nullptr, 10));
+        if (rounds == 0) {
+            rounds = 1;
+        }
+    }
+    std::printf("elements: %zu, rounds: %zu (time is the best of %d samples; ratio is opt::option / std::optional)\n",
+        element_count, rounds, samples);
+
+    run<int>("none", "int", [](std::size_t i) { return int(i); });
+    run<bool>("bool_", "bool", [](std::size_t i) { return i % 2 == 0; });
+    run<int*>("pointer_64/pointer_32", "int*", [](std::size_t i) { return storage + i; });
+    run<double>("float64", "double", [](std::size_t i) { return double(i) * 0.5; });
+    run<float>("float32", "float", [](std::size_t i) { return float(i) * 0.5f; });
+    run<std::reference_wrapper<int>>("reference_wrapper", "std::reference_wrapper<int>", [](std::size_t i) { return std::ref(storage[i]); });
+    run<std::pair<int*, int>>("pair", "std::pair<int*, int>", [](std::size_t i) { return std::pair<int*, int>{storage + i, int(i)}; });
+    run<std::tuple<int, double>>("tuple", "std::tuple<int, double>", [](std::size_t i) { return std::tuple<int, double>{int(i), double(i)}; });
+    run<std::array<float, 2>>("array", "std::array<float, 2>", [](std::size_t i) { return std::array<float, 2>{float(i), 1.f}; });
+    run<opt::option<double>>("avaliable_option", "opt::option<double>", [](std::size_t i) { return opt::option<double>{double(i)}; });
+    run<opt::option<int>>("unavaliable_option", "opt::option<int>", [](std::size_t i) { return opt::option<int>{int(i)}; });
+    run<polymorphic>("polymorphic", "polymorphic", [](std::size_t i) { return polymorphic{int(i)}; });
+    run<std::string_view>("string_view", "std::string_view", [](std::size_t i) { return std::string_view{"abcdefgh", i % 8}; });
+#if !OPTION_UNKNOWN_STD
+    run<std::string>("string", "std::string", [](std::size_t i) { return std::string(i % 8, 'a'); });
+    run<std::vector<int>>("vector", "std::vector<int>", [](std::size_t i) { return std::vector<int>(i % 4, 1); });
+#endif
+    run<std::unique_ptr<int>>("unique_ptr", "std::unique_ptr<int>", [](std::size_t i) { return std::make_unique<int>(int(i)); });
+    run<int member_struct::*>("member_pointer", "int member_struct::*", [](std::size_t i) { return i % 2 == 0 ? &member_struct::a : &member_struct::b; });
+    run<color>("enumeration_sentinel", "color", [](std::size_t i) { return color(i % 3); });
+    run<std::complex<double>>("complex", "std::complex<double>", [](std::size_t i) { return std::complex<double>{double(i), 1.0}; });
+}
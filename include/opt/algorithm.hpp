@@ -0,0 +1,1403 @@
+#pragma once
+
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <opt/option.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <functional>
+#include <limits>
+#include <vector>
+
+#ifndef OPTION_USE_SIMD
+    #define OPTION_USE_SIMD 1
+#endif
+
+#if OPTION_USE_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define OPTION_SIMD_SSE2 1
+    #if defined(__AVX2__)
+        #define OPTION_SIMD_AVX2 1
+    #else
+        #define OPTION_SIMD_AVX2 0
+    #endif
+    #if defined(__AVX512F__) && defined(__AVX512BW__)
+        #define OPTION_SIMD_AVX512 1
+    #else
+        #define OPTION_SIMD_AVX512 0
+    #endif
+    #include <immintrin.h>
+#else
+    #define OPTION_SIMD_SSE2 0
+    #define OPTION_SIMD_AVX2 0
+    #define OPTION_SIMD_AVX512 0
+#endif
+
+namespace opt {
+
+namespace impl {
+    inline std::size_t popcount64(std::uint64_t x) noexcept {
+#if OPTION_HAS_BUILTIN(__builtin_popcountll) || OPTION_GCC || OPTION_CLANG
+        return std::size_t(__builtin_popcountll(x));
+#else
+        // https://graphics.stanford.edu/%7Eseander/bithacks.html#CountBitsSetParallel
+        x = x - ((x >> 1) & 0x5555555555555555);
+        x = (x & 0x3333333333333333) + ((x >> 2) & 0x3333333333333333);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0F;
+        return std::size_t((x * 0x0101010101010101) >> 56);
+#endif
+    }
+
+    // Index of the lowest set bit. `x` must not be zero
+    inline std::size_t countr_zero64(const std::uint64_t x) noexcept {
+        OPTION_VERIFY(x != 0, "Counting trailing zeros of zero");
+#if OPTION_HAS_BUILTIN(__builtin_ctzll) || OPTION_GCC || OPTION_CLANG
+        return std::size_t(__builtin_ctzll(x));
+#else
+        std::size_t result = 0;
+        for (std::uint64_t y = x; (y & 1) == 0; y >>= 1) {
+            ++result;
+        }
+        return result;
+#endif
+    }
+
+    // Returns `true` if the option traits of `T` provide the `empty_representation` constant
+    template<class T>
+    constexpr bool has_traits_empty_representation() {
+        if constexpr (std::is_reference_v<T>) {
+            return false;
+        } else {
+            return opt::option_traits<T>::max_level > 0 && impl::has_empty_representation<T, opt::option_traits<T>>;
+        }
+    }
+
+    // Returns `true` if the empty state of `opt::option<T>` is a single bit pattern
+    // of the whole `opt::option<T>` object (every other bit pattern is a contained value)
+    template<class T>
+    constexpr bool has_empty_word_pattern() {
+        if constexpr (std::is_reference_v<T> || impl::has_traits_empty_representation<T>()) {
+            return true;
+        } else
+#if OPTION_USE_BUILTIN_TRAITS
+        if constexpr (std::is_base_of_v<internal_option_traits<T>, opt::option_traits<T>>) {
+            if constexpr (detemine_option_strategy<T>() == option_strategy::avaliable_option) {
+                return impl::has_empty_word_pattern<typename T::value_type>();
+            } else {
+                return false;
+            }
+        } else
+#endif
+        return false;
+    }
+
+    template<std::size_t Size>
+    struct word_of_size { using type = void; };
+    template<>
+    struct word_of_size<1> { using type = std::uint8_t; };
+    template<>
+    struct word_of_size<4> { using type = std::uint32_t; };
+    template<>
+    struct word_of_size<8> { using type = std::uint64_t; };
+
+    template<class T, bool = impl::has_empty_word_pattern<T>()>
+    struct option_word {
+        using type = void;
+    };
+    template<class T>
+    struct option_word<T, true> {
+        using type = typename word_of_size<sizeof(opt::option<T>)>::type;
+    };
+    // Unsigned integer type that has the same object representation as `opt::option<T>`,
+    // or `void` if the empty state of `opt::option<T>` cannot be checked by comparing a single integer
+    template<class T>
+    using option_word_t = typename option_word<T>::type;
+
+    template<class T>
+    inline option_word_t<T> empty_option_word() noexcept {
+        if constexpr (std::is_reference_v<T>) {
+            return option_word_t<T>(0);
+        } else
+        if constexpr (impl::has_traits_empty_representation<T>()) {
+            return option_word_t<T>(opt::option_traits<T>::empty_representation);
+        } else {
+            const opt::option<T> empty;
+            option_word_t<T> word;
+            std::memcpy(&word, OPTION_ADDRESSOF(empty), sizeof(word));
+            return word;
+        }
+    }
+
+    template<class Word>
+    inline Word load_word(const unsigned char* const ptr) noexcept {
+        Word word;
+        std::memcpy(&word, ptr, sizeof(Word));
+        return word;
+    }
+
+    inline constexpr std::size_t block_size = 64;
+
+    // Returns a mask, where each bit indicates that the corresponding word (of the `Count` words starting at `ptr`) is equal to `pattern`.
+    // Uses the widest vector instructions that evenly cover `Count` words
+    template<class Word, std::size_t Count>
+    inline std::uint64_t word_eq_mask(const unsigned char* const ptr, const Word pattern) noexcept {
+        static_assert(Count <= 64, "The mask must fit in std::uint64_t");
+        static_assert(sizeof(Word) == 1 || sizeof(Word) == 4 || sizeof(Word) == 8);
+
+        [[maybe_unused]] constexpr std::size_t bytes = Count * sizeof(Word);
+        std::uint64_t mask = 0;
+#if OPTION_SIMD_AVX512
+        if constexpr (bytes % 64 == 0) {
+            constexpr std::size_t lanes = 64 / sizeof(Word);
+            for (std::size_t i = 0; i < Count; i += lanes) {
+                const __m512i x = _mm512_loadu_si512(ptr + i * sizeof(Word));
+                if constexpr (sizeof(Word) == 8) {
+                    mask |= std::uint64_t(_mm512_cmpeq_epi64_mask(x, _mm512_set1_epi64(static_cast<long long>(pattern)))) << i;
+                } else
+                if constexpr (sizeof(Word) == 4) {
+                    mask |= std::uint64_t(_mm512_cmpeq_epi32_mask(x, _mm512_set1_epi32(static_cast<int>(pattern)))) << i;
+                } else {
+                    mask |= std::uint64_t(_mm512_cmpeq_epi8_mask(x, _mm512_set1_epi8(static_cast<char>(pattern)))) << i;
+                }
+            }
+        } else
+#endif
+#if OPTION_SIMD_AVX2
+        if constexpr (bytes % 32 == 0) {
+            constexpr std::size_t lanes = 32 / sizeof(Word);
+            for (std::size_t i = 0; i < Count; i += lanes) {
+                const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + i * sizeof(Word)));
+                if constexpr (sizeof(Word) == 8) {
+                    const __m256i eq = _mm256_cmpeq_epi64(x, _mm256_set1_epi64x(static_cast<long long>(pattern)));
+                    mask |= std::uint64_t(unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(eq)))) << i;
+                } else
+                if constexpr (sizeof(Word) == 4) {
+                    const __m256i eq = _mm256_cmpeq_epi32(x, _mm256_set1_epi32(static_cast<int>(pattern)));
+                    mask |= std::uint64_t(unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(eq)))) << i;
+                } else {
+                    const __m256i eq = _mm256_cmpeq_epi8(x, _mm256_set1_epi8(static_cast<char>(pattern)));
+                    mask |= std::uint64_t(std::uint32_t(_mm256_movemask_epi8(eq))) << i;
+                }
+            }
+        } else
+#endif
+#if OPTION_SIMD_SSE2
+        if constexpr (bytes % 16 == 0) {
+            constexpr std::size_t lanes = 16 / sizeof(Word);
+            for (std::size_t i = 0; i < Count; i += lanes) {
+                const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + i * sizeof(Word)));
+                if constexpr (sizeof(Word) == 8) {
+                    // SSE2 does not have a 64-bit comparison, so combine the comparisons of the 32-bit halves
+                    const __m128i eq32 = _mm_cmpeq_epi32(x, _mm_set1_epi64x(static_cast<long long>(pattern)));
+                    const __m128i eq64 = _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+                    mask |= std::uint64_t(unsigned(_mm_movemask_pd(_mm_castsi128_pd(eq64)))) << i;
+                } else
+                if constexpr (sizeof(Word) == 4) {
+                    const __m128i eq = _mm_cmpeq_epi32(x, _mm_set1_epi32(static_cast<int>(pattern)));
+                    mask |= std::uint64_t(unsigned(_mm_movemask_ps(_mm_castsi128_ps(eq)))) << i;
+                } else {
+                    const __m128i eq = _mm_cmpeq_epi8(x, _mm_set1_epi8(static_cast<char>(pattern)));
+                    mask |= std::uint64_t(unsigned(_mm_movemask_epi8(eq))) << i;
+                }
+            }
+        } else
+#endif
+        {
+            for (std::size_t i = 0; i < Count; ++i) {
+                mask |= std::uint64_t(impl::load_word<Word>(ptr + i * sizeof(Word)) == pattern) << i;
+            }
+        }
+        return mask;
+    }
+
+    // Same as `word_eq_mask`, but for the `count` (less than 64) words
+    template<class Word>
+    inline std::uint64_t empty_tail_mask(const unsigned char* const ptr, const std::size_t count, const Word empty) noexcept {
+        std::uint64_t mask = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            mask |= std::uint64_t(impl::load_word<Word>(ptr + i * sizeof(Word)) == empty) << i;
+        }
+        return mask;
+    }
+
+    inline constexpr std::uint64_t low_bits_mask(const std::size_t count) noexcept {
+        return count >= 64 ? ~std::uint64_t(0) : (std::uint64_t(1) << count) - 1;
+    }
+
+    // How the vectorized kernels load `opt::option<T>` into vector registers
+    enum class simd_layout {
+        // Not supported, the scalar loop is used
+        none,
+        // `opt::option<T>` has the same size as `T`, and the empty state is a single bit pattern
+        niche,
+        // `opt::option<T>` is `T` (4 or 8 bytes) followed by the `bool` flag and padding with the size of `T`
+        flag,
+    };
+
+    template<class T>
+    constexpr simd_layout get_simd_layout() {
+        if constexpr (std::is_reference_v<T> || !std::is_trivially_copyable_v<T>) {
+            return simd_layout::none;
+        } else
+        if constexpr (sizeof(opt::option<T>) == sizeof(T) && !std::is_void_v<impl::option_word_t<T>>) {
+            return simd_layout::niche;
+        } else
+        if constexpr (opt::option_traits<T>::max_level == 0 && (sizeof(T) == 4 || sizeof(T) == 8)
+            && sizeof(opt::option<T>) == 2 * sizeof(T) && std::is_trivially_copyable_v<opt::option<T>>
+        ) {
+            return simd_layout::flag;
+        } else {
+            return simd_layout::none;
+        }
+    }
+
+#if OPTION_SIMD_AVX2
+    struct simd_avx2 {
+        using reg = __m256i;
+        static constexpr std::size_t size = 32;
+
+        static reg load(const unsigned char* const ptr) noexcept {
+            return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+        }
+        static void store(unsigned char* const ptr, const reg x) noexcept {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), x);
+        }
+        template<class T>
+        static reg set1(const T value) noexcept {
+            if constexpr (sizeof(T) == 8) {
+                std::uint64_t word;
+                std::memcpy(&word, &value, sizeof(word));
+                return _mm256_set1_epi64x(static_cast<long long>(word));
+            } else
+            if constexpr (sizeof(T) == 2) {
+                short word;
+                std::memcpy(&word, &value, sizeof(word));
+                return _mm256_set1_epi16(word);
+            } else
+            if constexpr (sizeof(T) == 1) {
+                char word;
+                std::memcpy(&word, &value, sizeof(word));
+                return _mm256_set1_epi8(word);
+            } else {
+                std::uint32_t word;
+                std::memcpy(&word, &value, sizeof(word));
+                return _mm256_set1_epi32(static_cast<int>(word));
+            }
+        }
+        static reg zero() noexcept { return _mm256_setzero_si256(); }
+        static reg bit_and(const reg a, const reg b) noexcept { return _mm256_and_si256(a, b); }
+        static reg bit_or(const reg a, const reg b) noexcept { return _mm256_or_si256(a, b); }
+        // `~mask & x`
+        static reg bit_andnot(const reg mask, const reg x) noexcept { return _mm256_andnot_si256(mask, x); }
+        static reg ones() noexcept { return _mm256_set1_epi32(-1); }
+        static bool any(const reg x) noexcept { return _mm256_movemask_epi8(x) != 0; }
+        // Lanes of `a` where `mask` is set, otherwise lanes of `b`.
+        // Every lane of `mask` is either all ones or all zeros, so the bitwise operations are used, which fold when `a` is zero
+        static reg select(const reg mask, const reg a, const reg b) noexcept {
+            return _mm256_or_si256(_mm256_and_si256(mask, a), _mm256_andnot_si256(mask, b));
+        }
+
+        template<std::size_t Size>
+        static reg cmpeq(const reg a, const reg b) noexcept {
+            if constexpr (Size == 8) {
+                return _mm256_cmpeq_epi64(a, b);
+            } else
+            if constexpr (Size == 4) {
+                return _mm256_cmpeq_epi32(a, b);
+            } else {
+                return _mm256_cmpeq_epi8(a, b);
+            }
+        }
+        // Splits the (value, flag) pairs of `a` and `b` into the values and the flags (the order of the lanes is not preserved)
+        template<std::size_t Size>
+        static void deinterleave(const reg a, const reg b, reg& values, reg& flags) noexcept {
+            if constexpr (Size == 8) {
+                values = _mm256_unpacklo_epi64(a, b);
+                flags = _mm256_unpackhi_epi64(a, b);
+            } else {
+                const __m256 af = _mm256_castsi256_ps(a);
+                const __m256 bf = _mm256_castsi256_ps(b);
+                values = _mm256_castps_si256(_mm256_shuffle_ps(af, bf, _MM_SHUFFLE(2, 0, 2, 0)));
+                flags = _mm256_castps_si256(_mm256_shuffle_ps(af, bf, _MM_SHUFFLE(3, 1, 3, 1)));
+            }
+        }
+
+        // Restores the order of the values after `deinterleave`
+        static reg in_order(const reg values) noexcept {
+            return _mm256_permute4x64_epi64(values, _MM_SHUFFLE(3, 1, 2, 0));
+        }
+        // Mask of the whole options (of the `simd_layout::flag` layout with the value of `Size` bytes) that are empty
+        template<std::size_t Size>
+        static reg empty_options_mask(const reg x) noexcept {
+            if constexpr (Size == 8) {
+                const reg flags = _mm256_and_si256(x, _mm256_set_epi64x(0xFF, 0, 0xFF, 0));
+                return _mm256_shuffle_epi32(_mm256_cmpeq_epi32(flags, zero()), _MM_SHUFFLE(2, 2, 2, 2));
+            } else {
+                const reg flags = _mm256_and_si256(x, _mm256_set1_epi64x(0xFF00000000));
+                return _mm256_shuffle_epi32(_mm256_cmpeq_epi32(flags, zero()), _MM_SHUFFLE(3, 3, 1, 1));
+            }
+        }
+        // Repeats the 16 bytes at `ptr`
+        static reg broadcast16(const unsigned char* const ptr) noexcept {
+            return _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr)));
+        }
+
+        template<class T>
+        static reg add(const reg a, const reg b) noexcept {
+            if constexpr (std::is_same_v<T, double>) {
+                return _mm256_castpd_si256(_mm256_add_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+            } else
+            if constexpr (std::is_same_v<T, float>) {
+                return _mm256_castps_si256(_mm256_add_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+            } else
+            if constexpr (sizeof(T) == 8) {
+                return _mm256_add_epi64(a, b);
+            } else {
+                return _mm256_add_epi32(a, b);
+            }
+        }
+        // Mask of lanes where `a > b`, for the integer types
+        template<class T>
+        static reg cmpgt64(const reg a, const reg b) noexcept {
+            if constexpr (std::is_signed_v<T>) {
+                return _mm256_cmpgt_epi64(a, b);
+            } else {
+                const reg bias = _mm256_set1_epi64x(std::numeric_limits<long long>::min());
+                return _mm256_cmpgt_epi64(_mm256_xor_si256(a, bias), _mm256_xor_si256(b, bias));
+            }
+        }
+        template<class T>
+        static reg minimum(const reg a, const reg b) noexcept {
+            if constexpr (std::is_same_v<T, double>) {
+                return _mm256_castpd_si256(_mm256_min_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+            } else
+            if constexpr (std::is_same_v<T, float>) {
+                return _mm256_castps_si256(_mm256_min_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+            } else
+            if constexpr (sizeof(T) == 8) {
+                return select(cmpgt64<T>(a, b), b, a);
+            } else
+            if constexpr (std::is_signed_v<T>) {
+                return _mm256_min_epi32(a, b);
+            } else {
+                return _mm256_min_epu32(a, b);
+            }
+        }
+        template<class T>
+        static reg maximum(const reg a, const reg b) noexcept {
+            if constexpr (std::is_same_v<T, double>) {
+                return _mm256_castpd_si256(_mm256_max_pd(_mm256_castsi256_pd(a), _mm256_castsi256_pd(b)));
+            } else
+            if constexpr (std::is_same_v<T, float>) {
+                return _mm256_castps_si256(_mm256_max_ps(_mm256_castsi256_ps(a), _mm256_castsi256_ps(b)));
+            } else
+            if constexpr (sizeof(T) == 8) {
+                return select(cmpgt64<T>(a, b), a, b);
+            } else
+            if constexpr (std::is_signed_v<T>) {
+                return _mm256_max_epi32(a, b);
+            } else {
+                return _mm256_max_epu32(a, b);
+            }
+        }
+    };
+    using native_simd = simd_avx2;
+#elif OPTION_SIMD_SSE2
+    // SSE2 does not have the integer minimum/maximum and the 64-bit comparison, so only `float` and `double` are reduced
+    struct simd_sse2 {
+        using reg = __m128i;
+        static constexpr std::size_t size = 16;
+
+        static reg load(const unsigned char* const ptr) noexcept {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr));
+        }
+        static void store(unsigned char* const ptr, const reg x) noexcept {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(ptr), x);
+        }
+        template<class T>
+        static reg set1(const T value) noexcept {
+            if constexpr (sizeof(T) == 8) {
+                std::uint64_t word;
+                std::memcpy(&word, &value, sizeof(word));
+                return _mm_set1_epi64x(static_cast<long long>(word));
+            } else
+            if constexpr (sizeof(T) == 2) {
+                short word;
+                std::memcpy(&word, &value, sizeof(word));
+                return _mm_set1_epi16(word);
+            } else
+            if constexpr (sizeof(T) == 1) {
+                char word;
+                std::memcpy(&word, &value, sizeof(word));
+                return _mm_set1_epi8(word);
+            } else {
+                std::uint32_t word;
+                std::memcpy(&word, &value, sizeof(word));
+                return _mm_set1_epi32(static_cast<int>(word));
+            }
+        }
+        static reg zero() noexcept { return _mm_setzero_si128(); }
+        static reg bit_and(const reg a, const reg b) noexcept { return _mm_and_si128(a, b); }
+        static reg bit_or(const reg a, const reg b) noexcept { return _mm_or_si128(a, b); }
+        // `~mask & x`
+        static reg bit_andnot(const reg mask, const reg x) noexcept { return _mm_andnot_si128(mask, x); }
+        static reg ones() noexcept { return _mm_set1_epi32(-1); }
+        static bool any(const reg x) noexcept { return _mm_movemask_epi8(x) != 0; }
+        // Lanes of `a` where `mask` is set, otherwise lanes of `b`
+        static reg select(const reg mask, const reg a, const reg b) noexcept {
+            return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+        }
+
+        template<std::size_t Size>
+        static reg cmpeq(const reg a, const reg b) noexcept {
+            if constexpr (Size == 8) {
+                const reg eq32 = _mm_cmpeq_epi32(a, b);
+                return _mm_and_si128(eq32, _mm_shuffle_epi32(eq32, _MM_SHUFFLE(2, 3, 0, 1)));
+            } else
+            if constexpr (Size == 4) {
+                return _mm_cmpeq_epi32(a, b);
+            } else {
+                return _mm_cmpeq_epi8(a, b);
+            }
+        }
+        // Splits the (value, flag) pairs of `a` and `b` into the values and the flags (the order of the lanes is not preserved)
+        template<std::size_t Size>
+        static void deinterleave(const reg a, const reg b, reg& values, reg& flags) noexcept {
+            if constexpr (Size == 8) {
+                values = _mm_unpacklo_epi64(a, b);
+                flags = _mm_unpackhi_epi64(a, b);
+            } else {
+                const __m128 af = _mm_castsi128_ps(a);
+                const __m128 bf = _mm_castsi128_ps(b);
+                values = _mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(2, 0, 2, 0)));
+                flags = _mm_castps_si128(_mm_shuffle_ps(af, bf, _MM_SHUFFLE(3, 1, 3, 1)));
+            }
+        }
+
+        // Restores the order of the values after `deinterleave`
+        static reg in_order(const reg values) noexcept {
+            return values;
+        }
+        // Mask of the whole options (of the `simd_layout::flag` layout with the value of `Size` bytes) that are empty
+        template<std::size_t Size>
+        static reg empty_options_mask(const reg x) noexcept {
+            if constexpr (Size == 8) {
+                const reg flags = _mm_and_si128(x, _mm_set_epi64x(0xFF, 0));
+                return _mm_shuffle_epi32(_mm_cmpeq_epi32(flags, zero()), _MM_SHUFFLE(2, 2, 2, 2));
+            } else {
+                const reg flags = _mm_and_si128(x, _mm_set1_epi64x(0xFF00000000));
+                return _mm_shuffle_epi32(_mm_cmpeq_epi32(flags, zero()), _MM_SHUFFLE(3, 3, 1, 1));
+            }
+        }
+        // Repeats the 16 bytes at `ptr`
+        static reg broadcast16(const unsigned char* const ptr) noexcept {
+            return load(ptr);
+        }
+
+        template<class T>
+        static reg add(const reg a, const reg b) noexcept {
+            if constexpr (std::is_same_v<T, double>) {
+                return _mm_castpd_si128(_mm_add_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+            } else {
+                static_assert(std::is_same_v<T, float>);
+                return _mm_castps_si128(_mm_add_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+            }
+        }
+        template<class T>
+        static reg minimum(const reg a, const reg b) noexcept {
+            if constexpr (std::is_same_v<T, double>) {
+                return _mm_castpd_si128(_mm_min_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+            } else {
+                static_assert(std::is_same_v<T, float>);
+                return _mm_castps_si128(_mm_min_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+            }
+        }
+        template<class T>
+        static reg maximum(const reg a, const reg b) noexcept {
+            if constexpr (std::is_same_v<T, double>) {
+                return _mm_castpd_si128(_mm_max_pd(_mm_castsi128_pd(a), _mm_castsi128_pd(b)));
+            } else {
+                static_assert(std::is_same_v<T, float>);
+                return _mm_castps_si128(_mm_max_ps(_mm_castsi128_ps(a), _mm_castsi128_ps(b)));
+            }
+        }
+    };
+    using native_simd = simd_sse2;
+#endif
+
+    // Returns `true` if `opt::sum`, `opt::min_engaged` and `opt::max_engaged` use the vectorized kernel for `T`
+    template<class T>
+    constexpr bool has_reduce_kernel() {
+        if constexpr (!std::is_arithmetic_v<T> || std::is_same_v<T, bool> || !(sizeof(T) == 4 || sizeof(T) == 8)
+            || impl::get_simd_layout<T>() == simd_layout::none
+        ) {
+            return false;
+        } else
+        if constexpr (std::is_floating_point_v<T>) {
+            return OPTION_SIMD_SSE2;
+        } else {
+            return OPTION_SIMD_AVX2;
+        }
+    }
+
+    struct reduce_sum {
+        // The kernel must track whether any option contains a value
+        static constexpr bool needs_any = false;
+
+        template<class T>
+        static T identity() noexcept { return T(0); }
+
+        template<class T>
+        static T apply(const T& a, const T& b) {
+            if constexpr (std::is_integral_v<T> && !std::is_same_v<T, bool>) {
+                // Wrap around on overflow, same as the vector instructions
+                using uint = std::make_unsigned_t<T>;
+                return T(uint(uint(a) + uint(b)));
+            } else {
+                return a + b;
+            }
+        }
+#if OPTION_SIMD_SSE2
+        template<class Simd, class T>
+        static typename Simd::reg apply_vector(const typename Simd::reg a, const typename Simd::reg b) noexcept {
+            return Simd::template add<T>(a, b);
+        }
+#endif
+    };
+    struct reduce_min {
+        static constexpr bool needs_any = true;
+
+        template<class T>
+        static T identity() noexcept {
+            if constexpr (std::is_floating_point_v<T>) {
+                return std::numeric_limits<T>::infinity();
+            } else {
+                return (std::numeric_limits<T>::max)();
+            }
+        }
+
+        template<class T>
+        static const T& apply(const T& a, const T& b) {
+            return b < a ? b : a;
+        }
+#if OPTION_SIMD_SSE2
+        template<class Simd, class T>
+        static typename Simd::reg apply_vector(const typename Simd::reg a, const typename Simd::reg b) noexcept {
+            return Simd::template minimum<T>(a, b);
+        }
+#endif
+    };
+    struct reduce_max {
+        static constexpr bool needs_any = true;
+
+        template<class T>
+        static T identity() noexcept {
+            if constexpr (std::is_floating_point_v<T>) {
+                return -std::numeric_limits<T>::infinity();
+            } else {
+                return std::numeric_limits<T>::lowest();
+            }
+        }
+
+        template<class T>
+        static const T& apply(const T& a, const T& b) {
+            return a < b ? b : a;
+        }
+#if OPTION_SIMD_SSE2
+        template<class Simd, class T>
+        static typename Simd::reg apply_vector(const typename Simd::reg a, const typename Simd::reg b) noexcept {
+            return Simd::template maximum<T>(a, b);
+        }
+#endif
+    };
+
+    template<class T>
+    struct reduce_result {
+        T value;
+        // At least one option contains a value (only computed if `Op::needs_any`)
+        bool any;
+    };
+
+    // Reduces the contained values of the `n` options starting at `first` with `Op`.
+    // Empty options are replaced with the identity value of `Op` inside the vector registers, so the loop does not branch on `has_value()`
+    template<class Op, class T>
+    reduce_result<T> reduce_engaged_kernel(const opt::option<T>* const first, const std::size_t n) noexcept {
+        static_assert(impl::has_reduce_kernel<T>());
+
+        std::size_t i = 0;
+        reduce_result<T> result{Op::template identity<T>(), false};
+#if OPTION_SIMD_SSE2
+        using simd = impl::native_simd;
+        using reg = typename simd::reg;
+
+        constexpr bool is_niche = impl::get_simd_layout<T>() == simd_layout::niche;
+        constexpr std::size_t lanes = simd::size / sizeof(T);
+        // Four independent accumulators hide the latency of the vector operation
+        constexpr std::size_t accumulators = 4;
+
+        if (n >= accumulators * lanes) {
+            const auto* const bytes = reinterpret_cast<const unsigned char*>(first);
+            const reg identity = simd::set1(Op::template identity<T>());
+            reg pattern;
+            if constexpr (is_niche) {
+                pattern = simd::set1(impl::empty_option_word<T>());
+            } else {
+                // The `bool` flag is the first byte after the value, the rest is padding
+                pattern = simd::set1(typename word_of_size<sizeof(T)>::type(0xFF));
+            }
+
+            const auto blend_block = [&](const std::size_t index, reg& engaged) {
+                const unsigned char* const ptr = bytes + index * sizeof(opt::option<T>);
+
+                reg values;
+                reg empty;
+                if constexpr (is_niche) {
+                    values = simd::load(ptr);
+                    empty = simd::template cmpeq<sizeof(T)>(values, pattern);
+                } else {
+                    reg flags;
+                    simd::template deinterleave<sizeof(T)>(simd::load(ptr), simd::load(ptr + simd::size), values, flags);
+                    empty = simd::template cmpeq<sizeof(T)>(simd::bit_and(flags, pattern), simd::zero());
+                }
+                if constexpr (Op::needs_any) {
+                    engaged = simd::bit_or(engaged, simd::bit_andnot(empty, simd::ones()));
+                }
+                return simd::select(empty, identity, values);
+            };
+
+            reg acc0 = identity, acc1 = identity, acc2 = identity, acc3 = identity;
+            reg engaged = simd::zero();
+            for (; i + accumulators * lanes <= n; i += accumulators * lanes) {
+                acc0 = Op::template apply_vector<simd, T>(acc0, blend_block(i, engaged));
+                acc1 = Op::template apply_vector<simd, T>(acc1, blend_block(i + lanes, engaged));
+                acc2 = Op::template apply_vector<simd, T>(acc2, blend_block(i + 2 * lanes, engaged));
+                acc3 = Op::template apply_vector<simd, T>(acc3, blend_block(i + 3 * lanes, engaged));
+            }
+
+            const reg total = Op::template apply_vector<simd, T>(
+                Op::template apply_vector<simd, T>(acc0, acc1),
+                Op::template apply_vector<simd, T>(acc2, acc3)
+            );
+            T total_lanes[lanes];
+            std::memcpy(total_lanes, &total, sizeof(total));
+            for (const T& x : total_lanes) {
+                result.value = Op::apply(result.value, x);
+            }
+            result.any = simd::any(engaged);
+        }
+#endif
+        for (; i < n; ++i) {
+            if (first[i].has_value()) {
+                result.value = Op::apply(result.value, first[i].get());
+                result.any = true;
+            }
+        }
+        return result;
+    }
+
+    // Tables for packing the selected lanes of a vector to the beginning ("left-pack")
+    struct left_pack_tables {
+        // Byte `k` of `indices[mask]` is the index of the `k`-th set bit of `mask`
+        std::uint64_t indices[256];
+        // Number of set bits of `mask`
+        std::uint8_t counts[256];
+        // `mask` of 4 bits with every bit repeated twice
+        std::uint8_t pairs[16];
+    };
+
+    constexpr left_pack_tables make_left_pack_tables() {
+        left_pack_tables tables{};
+        for (unsigned mask = 0; mask < 256; ++mask) {
+            unsigned count = 0;
+            for (unsigned j = 0; j < 8; ++j) {
+                if (((mask >> j) & 1u) != 0) {
+                    tables.indices[mask] |= std::uint64_t(j) << (8 * count);
+                    ++count;
+                }
+            }
+            tables.counts[mask] = std::uint8_t(count);
+        }
+        for (unsigned mask = 0; mask < 16; ++mask) {
+            for (unsigned j = 0; j < 4; ++j) {
+                tables.pairs[mask] = std::uint8_t(tables.pairs[mask] | (((mask >> j) & 1u) * (3u << (2 * j))));
+            }
+        }
+        return tables;
+    }
+    inline constexpr left_pack_tables left_pack = impl::make_left_pack_tables();
+
+    // Returns `true` if `opt::compact` uses the vectorized kernel for `T`
+    template<class T>
+    constexpr bool has_compact_kernel() {
+        return OPTION_SIMD_AVX2 && (sizeof(T) == 4 || sizeof(T) == 8) && impl::get_simd_layout<T>() != simd_layout::none;
+    }
+
+#if OPTION_SIMD_AVX2
+    // Packs the contained values (and their indices) of the options starting at `in[i]` to `out_values[count]` (and `out_idx[count]`),
+    // while at least a full vector of options is left. Full vectors are stored, so the values after `count` are overwritten
+    template<class T>
+    void compact_kernel(const opt::option<T>* const in, const std::size_t n, T* const out_values, std::uint32_t* const out_idx, std::size_t& i, std::size_t& count) noexcept {
+        using simd = impl::simd_avx2;
+        using reg = typename simd::reg;
+        constexpr bool is_niche = impl::get_simd_layout<T>() == simd_layout::niche;
+        constexpr std::size_t lanes = simd::size / sizeof(T);
+
+        const auto* const in_bytes = reinterpret_cast<const unsigned char*>(in);
+        auto* const out_bytes = reinterpret_cast<unsigned char*>(out_values);
+#if OPTION_SIMD_AVX512
+        if constexpr (is_niche) {
+            constexpr std::size_t lanes512 = 64 / sizeof(T);
+            const __m512i iota = sizeof(T) == 4
+                ? _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15)
+                : _mm512_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7, 0, 0, 0, 0, 0, 0, 0, 0);
+
+            for (; i + lanes512 <= n; i += lanes512) {
+                const __m512i x = _mm512_loadu_si512(in_bytes + i * sizeof(T));
+                const __m512i idx = _mm512_add_epi32(_mm512_set1_epi32(static_cast<int>(i)), iota);
+                unsigned bits;
+                if constexpr (sizeof(T) == 4) {
+                    const __mmask16 engaged = _mm512_cmpneq_epi32_mask(x, _mm512_set1_epi32(static_cast<int>(impl::empty_option_word<T>())));
+                    _mm512_storeu_si512(out_bytes + count * sizeof(T), _mm512_maskz_compress_epi32(engaged, x));
+                    _mm512_storeu_si512(out_idx + count, _mm512_maskz_compress_epi32(engaged, idx));
+                    bits = engaged;
+                } else {
+                    const __mmask8 engaged = _mm512_cmpneq_epi64_mask(x, _mm512_set1_epi64(static_cast<long long>(impl::empty_option_word<T>())));
+                    _mm512_storeu_si512(out_bytes + count * sizeof(T), _mm512_maskz_compress_epi64(engaged, x));
+                    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_idx + count),
+                        _mm512_castsi512_si256(_mm512_maskz_compress_epi32(engaged, idx)));
+                    bits = engaged;
+                }
+                count += std::size_t(left_pack.counts[bits & 0xFF]) + left_pack.counts[bits >> 8];
+            }
+        }
+#endif
+        reg pattern;
+        if constexpr (is_niche) {
+            pattern = simd::set1(impl::empty_option_word<T>());
+        } else {
+            pattern = simd::set1(typename word_of_size<sizeof(T)>::type(0xFF));
+        }
+        const __m256i iota = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+        for (; i + lanes <= n; i += lanes) {
+            reg values;
+            reg empty;
+            if constexpr (is_niche) {
+                values = simd::load(in_bytes + i * sizeof(T));
+                empty = simd::template cmpeq<sizeof(T)>(values, pattern);
+            } else {
+                const unsigned char* const ptr = in_bytes + i * sizeof(opt::option<T>);
+                reg flags;
+                simd::template deinterleave<sizeof(T)>(simd::load(ptr), simd::load(ptr + simd::size), values, flags);
+                values = simd::in_order(values);
+                empty = simd::in_order(simd::template cmpeq<sizeof(T)>(simd::bit_and(flags, pattern), simd::zero()));
+            }
+            const __m256i idx = _mm256_add_epi32(_mm256_set1_epi32(static_cast<int>(i)), iota);
+
+            if constexpr (sizeof(T) == 4) {
+                const unsigned bits = ~unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(empty))) & 0xFFu;
+                const __m256i permutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&left_pack.indices[bits])));
+                simd::store(out_bytes + count * sizeof(T), _mm256_permutevar8x32_epi32(values, permutation));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(out_idx + count), _mm256_permutevar8x32_epi32(idx, permutation));
+                count += left_pack.counts[bits];
+            } else {
+                const unsigned bits = ~unsigned(_mm256_movemask_pd(_mm256_castsi256_pd(empty))) & 0xFu;
+                // Move the pairs of 32-bit halves of the values, and the 32-bit indices
+                const __m256i value_permutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&left_pack.indices[left_pack.pairs[bits]])));
+                const __m256i idx_permutation = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&left_pack.indices[bits])));
+                simd::store(out_bytes + count * sizeof(T), _mm256_permutevar8x32_epi32(values, value_permutation));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out_idx + count),
+                    _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(idx, idx_permutation)));
+                count += left_pack.counts[bits];
+            }
+        }
+    }
+#endif
+
+    // Writes `word` to each of the `n` words starting at `ptr`
+    template<class Word>
+    void splat_words(unsigned char* const ptr, const std::size_t n, const Word word) noexcept {
+        bool is_repeated_byte = true;
+        for (std::size_t i = 1; i < sizeof(Word); ++i) {
+            is_repeated_byte &= ((word >> (8 * i)) & 0xFF) == (word & 0xFF);
+        }
+        if (is_repeated_byte) {
+            std::memset(ptr, static_cast<int>(word & 0xFF), n * sizeof(Word));
+            return;
+        }
+        std::size_t i = 0;
+#if OPTION_SIMD_SSE2
+        using simd = impl::native_simd;
+        const typename simd::reg x = simd::set1(word);
+        for (; (i + simd::size / sizeof(Word)) <= n; i += simd::size / sizeof(Word)) {
+            simd::store(ptr + i * sizeof(Word), x);
+        }
+#endif
+        for (; i < n; ++i) {
+            std::memcpy(ptr + i * sizeof(Word), &word, sizeof(Word));
+        }
+    }
+
+    // Writes the empty state to the `n` objects of trivially copyable `opt::option<T>` starting at `ptr`.
+    // Returns `false` if the empty state cannot be written with a fill
+    template<class T>
+    bool fill_empty_state(void* const ptr, const std::size_t n) noexcept {
+        auto* const bytes = static_cast<unsigned char*>(ptr);
+        if (n == 0) {
+            // `ptr` may be a null pointer
+            return true;
+        }
+
+        if constexpr (!std::is_trivially_copyable_v<opt::option<T>>) {
+            return false;
+        } else
+        if constexpr (std::is_reference_v<T>) {
+            std::memset(bytes, 0, n * sizeof(opt::option<T>));
+            return true;
+        } else
+        if constexpr (impl::has_traits_empty_representation<T>()) {
+            impl::splat_words(bytes, n, opt::option_traits<T>::empty_representation);
+            return true;
+        } else
+        if constexpr (!std::is_void_v<impl::option_word_t<T>>) {
+            impl::splat_words(bytes, n, impl::empty_option_word<T>());
+            return true;
+        } else
+        if constexpr (opt::option_traits<T>::max_level == 0) {
+            // The `bool` flag is zero, the other bytes are not used in the empty state
+            std::memset(bytes, 0, n * sizeof(opt::option<T>));
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    // Maps the values of `T` to unsigned integers with the same order
+    template<class T, class = void>
+    struct order_preserving_key;
+
+    template<class T>
+    struct order_preserving_key<T, std::enable_if_t<std::is_integral_v<T> || std::is_enum_v<T>>> {
+    private:
+        using integer = typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::enable_if<true, T>>::type;
+        using uinteger = std::make_unsigned_t<std::conditional_t<std::is_same_v<integer, bool>, unsigned char, integer>>;
+        // Flipping the sign bit maps the signed values to the unsigned values in the same order
+        static constexpr uinteger flip = std::is_signed_v<integer> ? uinteger(uinteger(1) << (8 * sizeof(T) - 1)) : uinteger(0);
+    public:
+        using type = uinteger;
+
+        static type encode(const T value) noexcept {
+            return type(type(integer(value)) ^ flip);
+        }
+        static T decode(const type key) noexcept {
+            return T(integer(type(key ^ flip)));
+        }
+    };
+    template<class T>
+    struct order_preserving_key<T, std::enable_if_t<std::is_floating_point_v<T>>> {
+    private:
+        static_assert(sizeof(T) == 4 || sizeof(T) == 8, "Only 4 and 8 byte floating-point types are supported");
+        using uinteger = typename word_of_size<sizeof(T)>::type;
+        static constexpr uinteger sign = uinteger(uinteger(1) << (8 * sizeof(T) - 1));
+    public:
+        using type = uinteger;
+
+        // Negative values have all bits flipped (larger magnitude is smaller), positive values only have the sign bit flipped
+        static type encode(const T value) noexcept {
+            type bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            return (bits & sign) != 0 ? type(~bits) : type(bits | sign);
+        }
+        static T decode(const type key) noexcept {
+            const type bits = (key & sign) != 0 ? type(key ^ sign) : type(~key);
+            T value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    };
+}
+
+// `value` is the object representation of the empty `opt::option<T>`, as an unsigned integer of the same size.
+// Only defined if it is known at compile time: `T` is a reference, or the option traits of `T` provide the `empty_representation` member
+template<class T, class = void>
+struct empty_option_pattern {};
+
+template<class T>
+struct empty_option_pattern<T, std::enable_if_t<std::is_reference_v<T>>> {
+    using type = std::uintptr_t;
+    static constexpr type value = 0;
+};
+template<class T>
+struct empty_option_pattern<T, std::enable_if_t<impl::has_traits_empty_representation<T>()>> {
+    using type = std::remove_const_t<decltype(opt::option_traits<T>::empty_representation)>;
+    static constexpr type value = opt::option_traits<T>::empty_representation;
+};
+
+template<class T>
+inline constexpr auto empty_option_pattern_v = empty_option_pattern<T>::value;
+
+// Writes "has value" states of the `n` options starting at `first` into the bitmask `out_bits`.
+// The bit `i % 64` of `out_bits[i / 64]` is set if `first[i]` contains a value.
+// `out_bits` must have space for at least `(n + 63) / 64` words; bits after `n` in the last word are set to zero.
+template<class T>
+void has_value_mask(const opt::option<T>* const first, const std::size_t n, std::uint64_t* const out_bits) noexcept {
+    using word = impl::option_word_t<T>;
+
+    const std::size_t blocks = n / impl::block_size;
+    const std::size_t tail = n % impl::block_size;
+
+    if constexpr (!std::is_void_v<word>) {
+        const auto* const bytes = reinterpret_cast<const unsigned char*>(first);
+        const word empty = impl::empty_option_word<T>();
+
+        for (std::size_t i = 0; i < blocks; ++i) {
+            out_bits[i] = ~impl::word_eq_mask<word, impl::block_size>(bytes + i * impl::block_size * sizeof(word), empty);
+        }
+        if (tail != 0) {
+            const std::uint64_t mask = impl::empty_tail_mask<word>(bytes + blocks * impl::block_size * sizeof(word), tail, empty);
+            out_bits[blocks] = ~mask & impl::low_bits_mask(tail);
+        }
+    } else {
+        for (std::size_t i = 0; i < blocks + (tail != 0); ++i) {
+            const std::size_t count = i < blocks ? impl::block_size : tail;
+            const opt::option<T>* const block = first + i * impl::block_size;
+
+            std::uint64_t mask = 0;
+            for (std::size_t j = 0; j < count; ++j) {
+                mask |= std::uint64_t(block[j].has_value()) << j;
+            }
+            out_bits[i] = mask;
+        }
+    }
+}
+
+// Returns the number of options that contain a value in the range [`first`, `first + n`)
+template<class T>
+[[nodiscard]] std::size_t count_engaged(const opt::option<T>* const first, const std::size_t n) noexcept {
+    using word = impl::option_word_t<T>;
+
+    if constexpr (!std::is_void_v<word>) {
+        const std::size_t blocks = n / impl::block_size;
+        const std::size_t tail = n % impl::block_size;
+
+        const auto* const bytes = reinterpret_cast<const unsigned char*>(first);
+        const word empty = impl::empty_option_word<T>();
+
+        std::size_t empty_count = 0;
+        for (std::size_t i = 0; i < blocks; ++i) {
+            empty_count += impl::popcount64(impl::word_eq_mask<word, impl::block_size>(bytes + i * impl::block_size * sizeof(word), empty));
+        }
+        if (tail != 0) {
+            empty_count += impl::popcount64(impl::empty_tail_mask<word>(bytes + blocks * impl::block_size * sizeof(word), tail, empty));
+        }
+        return n - empty_count;
+    } else {
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            result += std::size_t(first[i].has_value());
+        }
+        return result;
+    }
+}
+
+// Returns the sum of the contained values in the range [`first`, `last`), or `T(0)` if there are none.
+// The values are added in an unspecified order. The sum of integers wraps around on overflow
+template<class T>
+[[nodiscard]] T sum(const opt::option<T>* const first, const opt::option<T>* const last) {
+    const std::size_t n = std::size_t(last - first);
+
+    if constexpr (impl::has_reduce_kernel<T>()) {
+        return impl::reduce_engaged_kernel<impl::reduce_sum>(first, n).value;
+    } else {
+        T result = T(0);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (first[i].has_value()) {
+                result = impl::reduce_sum::apply(result, first[i].get());
+            }
+        }
+        return result;
+    }
+}
+
+// Reduces the contained values in the range [`first`, `last`) with the binary operation `op`, starting with `init`.
+// Empty options are skipped. Like `std::reduce`, the values may be grouped and combined in an unspecified order.
+// If `op` is `std::plus` and `opt::sum` is vectorized for `T`, returns `op(init, opt::sum(first, last))`
+template<class T, class U, class BinaryOp>
+[[nodiscard]] U reduce_engaged(const opt::option<T>* const first, const opt::option<T>* const last, U init, BinaryOp op) {
+    using word = impl::option_word_t<T>;
+    const std::size_t n = std::size_t(last - first);
+
+    if constexpr ((std::is_same_v<BinaryOp, std::plus<>> || std::is_same_v<BinaryOp, std::plus<T>>)
+        && std::is_same_v<U, T> && impl::has_reduce_kernel<T>()
+    ) {
+        return op(static_cast<U&&>(init), opt::sum(first, last));
+    } else
+    if constexpr (!std::is_void_v<word>) {
+        // Visit only the set bits of the "has value" mask instead of branching on every element
+        const auto* const bytes = reinterpret_cast<const unsigned char*>(first);
+        const word empty = impl::empty_option_word<T>();
+
+        for (std::size_t i = 0; i < n; i += impl::block_size) {
+            const std::size_t count = n - i < impl::block_size ? n - i : impl::block_size;
+            const unsigned char* const block = bytes + i * sizeof(word);
+
+            std::uint64_t bits = count == impl::block_size
+                ? ~impl::word_eq_mask<word, impl::block_size>(block, empty)
+                : ~impl::empty_tail_mask<word>(block, count, empty) & impl::low_bits_mask(count);
+            for (; bits != 0; bits &= bits - 1) {
+                init = op(static_cast<U&&>(init), first[i + impl::countr_zero64(bits)].get());
+            }
+        }
+        return init;
+    } else {
+        for (std::size_t i = 0; i < n; ++i) {
+            if (first[i].has_value()) {
+                init = op(static_cast<U&&>(init), first[i].get());
+            }
+        }
+        return init;
+    }
+}
+
+// Returns the smallest contained value in the range [`first`, `last`), or an empty option if there are none.
+// If one of the values is NaN, the result is unspecified
+template<class T>
+[[nodiscard]] opt::option<T> min_engaged(const opt::option<T>* const first, const opt::option<T>* const last) {
+    const std::size_t n = std::size_t(last - first);
+
+    if constexpr (impl::has_reduce_kernel<T>()) {
+        const impl::reduce_result<T> result = impl::reduce_engaged_kernel<impl::reduce_min>(first, n);
+        return result.any ? opt::option<T>{result.value} : opt::option<T>{};
+    } else {
+        const opt::option<T>* best = nullptr;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (first[i].has_value() && (best == nullptr || first[i].get() < best->get())) {
+                best = first + i;
+            }
+        }
+        return best == nullptr ? opt::option<T>{} : *best;
+    }
+}
+
+// Returns the largest contained value in the range [`first`, `last`), or an empty option if there are none.
+// If one of the values is NaN, the result is unspecified
+template<class T>
+[[nodiscard]] opt::option<T> max_engaged(const opt::option<T>* const first, const opt::option<T>* const last) {
+    const std::size_t n = std::size_t(last - first);
+
+    if constexpr (impl::has_reduce_kernel<T>()) {
+        const impl::reduce_result<T> result = impl::reduce_engaged_kernel<impl::reduce_max>(first, n);
+        return result.any ? opt::option<T>{result.value} : opt::option<T>{};
+    } else {
+        const opt::option<T>* best = nullptr;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (first[i].has_value() && (best == nullptr || best->get() < first[i].get())) {
+                best = first + i;
+            }
+        }
+        return best == nullptr ? opt::option<T>{} : *best;
+    }
+}
+
+// Returns the arithmetic mean of the contained values in the range [`first`, `last`), or an empty option if there are none.
+// `T` must be a floating-point type
+template<class T>
+[[nodiscard]] opt::option<T> mean_engaged(const opt::option<T>* const first, const opt::option<T>* const last) {
+    static_assert(std::is_floating_point_v<T>, "The type must be a floating-point type");
+    const std::size_t count = opt::count_engaged(first, std::size_t(last - first));
+    if (count == 0) {
+        return opt::option<T>{};
+    }
+    return opt::option<T>{opt::sum(first, last) / T(count)};
+}
+
+// Writes the contained value of each of the `n` options starting at `in`, or `dflt` if the option is empty, to `out[i]`.
+// Same as `out[i] = in[i].value_or(dflt)`, but does not branch on `has_value()` if `T` is trivially copyable
+template<class T>
+void value_or_n(const opt::option<T>* const in, const std::size_t n, const T& dflt, T* const out) {
+    static_assert(!std::is_reference_v<T>, "The type must not be a reference");
+    constexpr impl::simd_layout layout = impl::get_simd_layout<T>();
+
+    std::size_t i = 0;
+    if constexpr (layout == impl::simd_layout::niche) {
+        using word = impl::option_word_t<T>;
+        const auto* const in_bytes = reinterpret_cast<const unsigned char*>(in);
+        auto* const out_bytes = reinterpret_cast<unsigned char*>(out);
+        const word empty = impl::empty_option_word<T>();
+        word dflt_word;
+        std::memcpy(&dflt_word, OPTION_ADDRESSOF(dflt), sizeof(word));
+#if OPTION_SIMD_SSE2
+        using simd = impl::native_simd;
+        constexpr std::size_t lanes = simd::size / sizeof(word);
+
+        const typename simd::reg empty_v = simd::set1(empty);
+        const typename simd::reg dflt_v = simd::set1(dflt_word);
+        for (; i + lanes <= n; i += lanes) {
+            const typename simd::reg x = simd::load(in_bytes + i * sizeof(word));
+            simd::store(out_bytes + i * sizeof(word), simd::select(simd::template cmpeq<sizeof(word)>(x, empty_v), dflt_v, x));
+        }
+#endif
+        for (; i < n; ++i) {
+            const word x = impl::load_word<word>(in_bytes + i * sizeof(word));
+            const word result = x == empty ? dflt_word : x;
+            std::memcpy(out_bytes + i * sizeof(word), &result, sizeof(word));
+        }
+    } else {
+#if OPTION_SIMD_SSE2
+        if constexpr (layout == impl::simd_layout::flag) {
+            using simd = impl::native_simd;
+            using reg = typename simd::reg;
+            constexpr std::size_t lanes = simd::size / sizeof(T);
+
+            const auto* const in_bytes = reinterpret_cast<const unsigned char*>(in);
+            auto* const out_bytes = reinterpret_cast<unsigned char*>(out);
+            const reg dflt_v = simd::set1(dflt);
+            const reg flag_mask = simd::set1(typename impl::word_of_size<sizeof(T)>::type(0xFF));
+            for (; i + lanes <= n; i += lanes) {
+                const unsigned char* const ptr = in_bytes + i * sizeof(opt::option<T>);
+                reg values;
+                reg flags;
+                simd::template deinterleave<sizeof(T)>(simd::load(ptr), simd::load(ptr + simd::size), values, flags);
+                const reg empty = simd::template cmpeq<sizeof(T)>(simd::bit_and(flags, flag_mask), simd::zero());
+                simd::store(out_bytes + i * sizeof(T), simd::in_order(simd::select(empty, dflt_v, values)));
+            }
+        }
+#endif
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            // The value of `opt::option<T>` is always stored at the beginning of the object
+            for (; i < n; ++i) {
+                const void* const source = in[i].has_value() ? static_cast<const void*>(in + i) : static_cast<const void*>(OPTION_ADDRESSOF(dflt));
+                std::memcpy(out + i, source, sizeof(T));
+            }
+        } else {
+            for (; i < n; ++i) {
+                out[i] = in[i].has_value() ? in[i].get() : dflt;
+            }
+        }
+    }
+}
+
+// Replaces each empty option of the `n` options starting at `first` with an option containing `value`.
+// Same as `if (!first[i]) first[i] = value`, but does not branch on `has_value()` if `opt::option<T>` is trivially copyable
+template<class T>
+void fill_empty(opt::option<T>* const first, const std::size_t n, const T& value) {
+    static_assert(!std::is_reference_v<T>, "The type must not be a reference");
+    constexpr impl::simd_layout layout = impl::get_simd_layout<T>();
+
+    std::size_t i = 0;
+    if constexpr (layout == impl::simd_layout::niche) {
+        using word = impl::option_word_t<T>;
+        auto* const bytes = reinterpret_cast<unsigned char*>(first);
+        const word empty = impl::empty_option_word<T>();
+        word value_word;
+        std::memcpy(&value_word, OPTION_ADDRESSOF(value), sizeof(word));
+#if OPTION_SIMD_SSE2
+        using simd = impl::native_simd;
+        constexpr std::size_t lanes = simd::size / sizeof(word);
+
+        const typename simd::reg empty_v = simd::set1(empty);
+        const typename simd::reg value_v = simd::set1(value_word);
+        for (; i + lanes <= n; i += lanes) {
+            const typename simd::reg x = simd::load(bytes + i * sizeof(word));
+            simd::store(bytes + i * sizeof(word), simd::select(simd::template cmpeq<sizeof(word)>(x, empty_v), value_v, x));
+        }
+#endif
+        for (; i < n; ++i) {
+            const word x = impl::load_word<word>(bytes + i * sizeof(word));
+            const word result = x == empty ? value_word : x;
+            std::memcpy(bytes + i * sizeof(word), &result, sizeof(word));
+        }
+    } else
+    if constexpr (std::is_trivially_copyable_v<opt::option<T>>) {
+        const opt::option<T> engaged{value};
+#if OPTION_SIMD_SSE2
+        if constexpr (layout == impl::simd_layout::flag) {
+            using simd = impl::native_simd;
+            using reg = typename simd::reg;
+            constexpr std::size_t options_per_reg = simd::size / sizeof(opt::option<T>);
+
+            auto* const bytes = reinterpret_cast<unsigned char*>(first);
+            reg engaged_v;
+            if constexpr (sizeof(T) == 8) {
+                engaged_v = simd::broadcast16(reinterpret_cast<const unsigned char*>(OPTION_ADDRESSOF(engaged)));
+            } else {
+                engaged_v = simd::set1(impl::load_word<std::uint64_t>(reinterpret_cast<const unsigned char*>(OPTION_ADDRESSOF(engaged))));
+            }
+            for (; i + options_per_reg <= n; i += options_per_reg) {
+                const reg x = simd::load(bytes + i * sizeof(opt::option<T>));
+                simd::store(bytes + i * sizeof(opt::option<T>), simd::select(simd::template empty_options_mask<sizeof(T)>(x), engaged_v, x));
+            }
+        }
+#endif
+        for (; i < n; ++i) {
+            first[i] = first[i].has_value() ? first[i] : engaged;
+        }
+    } else {
+        for (; i < n; ++i) {
+            if (!first[i].has_value()) {
+                first[i].emplace(value);
+            }
+        }
+    }
+}
+
+// Resets the `n` options starting at `first`, destroying the contained values.
+// If `opt::option<T>` is trivially copyable and the empty state is a constant (or only the `bool` flag must be cleared),
+// the options are filled with `std::memset` or with vector stores
+template<class T>
+void reset_n(opt::option<T>* const first, const std::size_t n) noexcept {
+    if (!impl::fill_empty_state<T>(first, n)) {
+        for (std::size_t i = 0; i < n; ++i) {
+            first[i].reset();
+        }
+    }
+}
+
+// Constructs the `n` empty options in the uninitialized storage starting at `first`.
+// Returns the end of the constructed range. Uses the same techniques as `opt::reset_n`
+template<class T>
+opt::option<T>* uninitialized_default_construct_n(opt::option<T>* const first, const std::size_t n) noexcept {
+    if (!impl::fill_empty_state<T>(first, n)) {
+        for (std::size_t i = 0; i < n; ++i) {
+            ::new(static_cast<void*>(first + i)) opt::option<T>();
+        }
+    }
+    return first + n;
+}
+
+
+// Writes the contained values of the `n` options starting at `in` to `out_values`, and their indices to `out_idx` (in the same order).
+// Returns the number of written values.
+// `out_values` and `out_idx` must have space for `n` elements; the elements after the returned count may be overwritten
+template<class T>
+[[nodiscard]] std::size_t compact(const opt::option<T>* const in, const std::size_t n, T* const out_values, std::uint32_t* const out_idx) {
+    static_assert(!std::is_reference_v<T>, "The type must not be a reference");
+    OPTION_VERIFY(n == 0 || n - 1 <= (std::numeric_limits<std::uint32_t>::max)(), "The indices must fit in std::uint32_t");
+
+    std::size_t i = 0;
+    std::size_t count = 0;
+#if OPTION_SIMD_AVX2
+    if constexpr (impl::has_compact_kernel<T>()) {
+        impl::compact_kernel(in, n, out_values, out_idx, i, count);
+    }
+#endif
+    if constexpr (std::is_trivially_copyable_v<T> && !std::is_same_v<T, bool>) {
+        // Always write the value (the value of `opt::option<T>` is stored at the beginning of the object),
+        // but advance the output only if the option is not empty
+        for (; i < n; ++i) {
+            std::memcpy(out_values + count, in + i, sizeof(T));
+            out_idx[count] = std::uint32_t(i);
+            count += std::size_t(in[i].has_value());
+        }
+    } else {
+        for (; i < n; ++i) {
+            if (in[i].has_value()) {
+                out_values[count] = in[i].get();
+                out_idx[count] = std::uint32_t(i);
+                ++count;
+            }
+        }
+    }
+    return count;
+}
+
+// Inverse of `opt::compact`. Resets the `n` options starting at `out`,
+// then constructs the value `values[k]` in the option `out[idx[k]]` for each `k` in [`0`, `count`).
+// Every `idx[k]` must be less than `n`
+template<class T>
+void expand(const T* const values, const std::uint32_t* const idx, const std::size_t count, opt::option<T>* const out, const std::size_t n) {
+    static_assert(!std::is_reference_v<T>, "The type must not be a reference");
+
+    opt::reset_n(out, n);
+    for (std::size_t k = 0; k < count; ++k) {
+        OPTION_VERIFY(idx[k] < n, "Index out of range");
+        out[idx[k]].emplace(values[k]);
+    }
+}
+
+// Position of the empty options in the sort order
+enum class nulls {
+    // Empty options are less than any contained value (same as `operator<` of `opt::option`)
+    first,
+    // Empty options are greater than any contained value
+    last,
+};
+
+// Size of the key written by `opt::sort_key` for `opt::option<T>`
+template<class T>
+inline constexpr std::size_t sort_key_size = 1 + sizeof(T);
+
+// Writes the key of `value` (`opt::sort_key_size<T>` bytes) to `out`, so that comparing the keys with `std::memcmp` gives the order of the options.
+// `T` must be an integral, enumeration or floating-point type.
+// Floating-point values are ordered by their sign and magnitude: `-0.0` is less than `+0.0`, NaN values are ordered by their bits
+template<class T>
+void sort_key(const opt::option<T>& value, std::byte* const out, const nulls order = nulls::first) noexcept {
+    using key = impl::order_preserving_key<T>;
+
+    out[0] = std::byte(value.has_value() == (order == nulls::first));
+    const typename key::type bits = value.has_value() ? key::encode(value.get()) : typename key::type(0);
+    // Big-endian, so the most significant byte is compared first
+    for (std::size_t i = 0; i < sizeof(bits); ++i) {
+        out[1 + i] = std::byte((bits >> (8 * (sizeof(bits) - 1 - i))) & 0xFF);
+    }
+}
+
+// Sorts the `n` options starting at `first` in the order of `opt::sort_key` with least significant digit radix sort.
+// `T` must be an integral, enumeration or floating-point type. Allocates the buffer for the contained values
+template<class T>
+void radix_sort(opt::option<T>* const first, const std::size_t n, const nulls order = nulls::first) {
+    using key = impl::order_preserving_key<T>;
+    using key_type = typename key::type;
+    constexpr std::size_t digits = sizeof(key_type);
+
+    std::vector<key_type> keys(n);
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (first[i].has_value()) {
+            keys[count] = key::encode(first[i].get());
+            ++count;
+        }
+    }
+
+    // Histograms of all digits in one pass
+    std::size_t histograms[digits][256]{};
+    for (std::size_t i = 0; i < count; ++i) {
+        for (std::size_t d = 0; d < digits; ++d) {
+            ++histograms[d][(keys[i] >> (8 * d)) & 0xFF];
+        }
+    }
+
+    std::vector<key_type> buffer(count);
+    key_type* source = keys.data();
+    key_type* destination = buffer.data();
+    for (std::size_t d = 0; d < digits; ++d) {
+        std::size_t* const histogram = histograms[d];
+        // Every key has the same digit, so the pass would not change the order
+        if (count == 0 || histogram[(source[0] >> (8 * d)) & 0xFF] == count) {
+            continue;
+        }
+        std::size_t offset = 0;
+        for (std::size_t b = 0; b < 256; ++b) {
+            const std::size_t bucket_size = histogram[b];
+            histogram[b] = offset;
+            offset += bucket_size;
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            destination[histogram[(source[i] >> (8 * d)) & 0xFF]++] = source[i];
+        }
+        std::swap(source, destination);
+    }
+
+    const std::size_t empty_count = n - count;
+    opt::option<T>* const values = order == nulls::first ? first + empty_count : first;
+    opt::reset_n(order == nulls::first ? first : first + count, empty_count);
+    for (std::size_t i = 0; i < count; ++i) {
+        values[i] = key::decode(source[i]);
+    }
+}
+
+}
+
@@ -0,0 +1,173 @@
+#pragma once
+
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <opt/option.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace opt {
+
+namespace impl {
+    constexpr std::size_t log2_of_pow2(const std::size_t value) noexcept {
+        std::size_t result = 0;
+        while ((std::size_t(1) << result) < value) {
+            ++result;
+        }
+        return result;
+    }
+
+    template<class T, std::size_t Alignment>
+    struct aligned_ptr_alignment {
+        static constexpr std::size_t value = Alignment;
+    };
+    template<class T>
+    struct aligned_ptr_alignment<T, 0> {
+        static constexpr std::size_t value = alignof(T);
+    };
+}
+
+// Pointer to `T`, that is always aligned to `Alignment` (`alignof(T)` if `Alignment` is 0).
+// Every misaligned address is an unused state, so `opt::option<opt::aligned_ptr<T>>` has the same size as `T*`,
+// with a very large `max_level`.
+// For incomplete types (e.g. in a node of an intrusive tree) the alignment must be specified explicitly
+template<class T, std::size_t Alignment = 0>
+class aligned_ptr {
+    T* ptr;
+public:
+    aligned_ptr() noexcept : ptr{nullptr} {}
+    aligned_ptr(std::nullptr_t) noexcept : ptr{nullptr} {}
+    aligned_ptr(T* const ptr_) noexcept : ptr{ptr_} {
+        static_assert(impl::aligned_ptr_alignment<T, Alignment>::value <= alignof(T),
+            "The alignment of opt::aligned_ptr must not be greater than the alignment of T");
+        OPTION_VERIFY((reinterpret_cast<std::uintptr_t>(ptr_) % impl::aligned_ptr_alignment<T, Alignment>::value) == 0,
+            "The pointer must be aligned");
+    }
+
+    [[nodiscard]] T* get() const noexcept { return ptr; }
+    operator T*() const noexcept { return ptr; }
+
+    [[nodiscard]] T& operator*() const noexcept { return *ptr; }
+    [[nodiscard]] T* operator->() const noexcept { return ptr; }
+
+    [[nodiscard]] explicit operator bool() const noexcept { return ptr != nullptr; }
+
+    [[nodiscard]] friend bool operator==(const aligned_ptr left, const aligned_ptr right) noexcept { return left.ptr == right.ptr; }
+    [[nodiscard]] friend bool operator!=(const aligned_ptr left, const aligned_ptr right) noexcept { return left.ptr != right.ptr; }
+};
+
+template<class T, std::size_t Alignment>
+struct option_traits<aligned_ptr<T, Alignment>> {
+private:
+    using value_t = aligned_ptr<T, Alignment>;
+
+    static constexpr std::uintptr_t alignment = impl::aligned_ptr_alignment<T, Alignment>::value;
+    static_assert(alignment >= 2 && (alignment & (alignment - 1)) == 0,
+        "The alignment of opt::aligned_ptr must be a power of 2 greater than 1");
+
+    static constexpr std::size_t shift = impl::log2_of_pow2(alignment);
+    static constexpr std::uintptr_t low_mask = alignment - 1;
+
+    static std::uintptr_t load(const value_t* const value) noexcept {
+        std::uintptr_t uint{};
+        std::memcpy(&uint, value, sizeof(uint));
+        return uint;
+    }
+public:
+    // Each aligned address is followed by `alignment - 1` misaligned addresses
+    static constexpr std::uintmax_t max_level = std::uintmax_t(std::uintptr_t(-1) >> shift) * (alignment - 1) + (alignment - 1);
+
+    static std::uintmax_t get_level(const value_t* const value) noexcept {
+        const std::uintptr_t uint = load(value);
+        const std::uintptr_t low = uint & low_mask;
+        if (low == 0) {
+            return std::uintmax_t(-1);
+        }
+        return std::uintmax_t(uint >> shift) * (alignment - 1) + (low - 1);
+    }
+    static void set_level(value_t* const value, const std::uintmax_t level) noexcept {
+        OPTION_VERIFY(level < max_level, "Level is out of range");
+        const std::uintptr_t uint = (std::uintptr_t(level / (alignment - 1)) << shift) | std::uintptr_t(level % (alignment - 1) + 1);
+        std::memcpy(static_cast<void*>(value), &uint, sizeof(uint));
+    }
+};
+
+// Pointer to `T`, that stores `Bits` user-defined tag bits in its low (alignment) bits.
+// `opt::option<opt::tagged_ptr<T, Bits>>` has the same size as `T*`: the unused states are taken from `opt::option_traits<T*>`
+// (the addresses, that can't be valid pointers, with any tag bits).
+// `2^Bits` must not be greater than the alignment of `T`
+template<class T, std::size_t Bits>
+class tagged_ptr {
+    static_assert(Bits > 0 && Bits < 8, "The number of tag bits of opt::tagged_ptr must be in the range [1, 7]");
+
+    std::uintptr_t bits;
+
+    static void check_alignment() noexcept {
+        static_assert((std::size_t(1) << Bits) <= alignof(T),
+            "The tag bits of opt::tagged_ptr must fit into the alignment bits of T");
+    }
+public:
+    static constexpr std::size_t tag_bits = Bits;
+    static constexpr std::uintptr_t tag_mask = (std::uintptr_t(1) << Bits) - 1;
+
+    tagged_ptr() noexcept : bits{0} {}
+    tagged_ptr(std::nullptr_t) noexcept : bits{0} {}
+    explicit tagged_ptr(T* const ptr, const std::uintptr_t tag = 0) noexcept
+        : bits{reinterpret_cast<std::uintptr_t>(ptr) | tag} {
+        check_alignment();
+        OPTION_VERIFY((reinterpret_cast<std::uintptr_t>(ptr) & tag_mask) == 0, "The pointer must be aligned");
+        OPTION_VERIFY((tag & ~tag_mask) == 0, "The tag is out of range");
+    }
+
+    [[nodiscard]] T* get() const noexcept { return reinterpret_cast<T*>(bits & ~tag_mask); }
+    [[nodiscard]] std::uintptr_t tag() const noexcept { return bits & tag_mask; }
+
+    void set(T* const ptr) noexcept {
+        check_alignment();
+        OPTION_VERIFY((reinterpret_cast<std::uintptr_t>(ptr) & tag_mask) == 0, "The pointer must be aligned");
+        bits = reinterpret_cast<std::uintptr_t>(ptr) | (bits & tag_mask);
+    }
+    void set_tag(const std::uintptr_t tag) noexcept {
+        OPTION_VERIFY((tag & ~tag_mask) == 0, "The tag is out of range");
+        bits = (bits & ~tag_mask) | tag;
+    }
+
+    [[nodiscard]] T& operator*() const noexcept { return *get(); }
+    [[nodiscard]] T* operator->() const noexcept { return get(); }
+
+    // `true` if the pointer (without the tag) is not null
+    [[nodiscard]] explicit operator bool() const noexcept { return get() != nullptr; }
+
+    // Compares both the pointers and the tags
+    [[nodiscard]] friend bool operator==(const tagged_ptr left, const tagged_ptr right) noexcept { return left.bits == right.bits; }
+    [[nodiscard]] friend bool operator!=(const tagged_ptr left, const tagged_ptr right) noexcept { return left.bits != right.bits; }
+};
+
+template<class T, std::size_t Bits>
+struct option_traits<tagged_ptr<T, Bits>> {
+private:
+    using value_t = tagged_ptr<T, Bits>;
+    using traits = opt::option_traits<T*>;
+
+    static_assert(sizeof(value_t) == sizeof(T*));
+public:
+    // A valid pointer with any tag bits is still a valid address, so it's never in the range of the unused states
+    static constexpr std::uintmax_t max_level = traits::max_level;
+
+    static std::uintmax_t get_level(const value_t* const value) noexcept {
+        T* ptr{};
+        std::memcpy(&ptr, value, sizeof(ptr));
+        return traits::get_level(OPTION_ADDRESSOF(ptr));
+    }
+    static void set_level(value_t* const value, const std::uintmax_t level) noexcept {
+        T* ptr{};
+        traits::set_level(OPTION_ADDRESSOF(ptr), level);
+        std::memcpy(static_cast<void*>(value), &ptr, sizeof(ptr));
+    }
+};
+
+}
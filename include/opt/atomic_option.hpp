@@ -0,0 +1,157 @@
+#pragma once
+
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <opt/option.hpp>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace opt {
+
+namespace impl {
+    template<std::size_t Size>
+    struct atomic_word_of_size { using type = void; };
+    template<>
+    struct atomic_word_of_size<1> { using type = std::uint8_t; };
+    template<>
+    struct atomic_word_of_size<2> { using type = std::uint16_t; };
+    template<>
+    struct atomic_word_of_size<4> { using type = std::uint32_t; };
+    template<>
+    struct atomic_word_of_size<8> { using type = std::uint64_t; };
+
+    constexpr std::memory_order atomic_failure_order(const std::memory_order order) noexcept {
+        return order == std::memory_order_acq_rel ? std::memory_order_acquire
+            : order == std::memory_order_release ? std::memory_order_relaxed
+            : order;
+    }
+}
+
+// Atomic `opt::option<T>` for types, that have `opt::option_traits` (the "has value" state is encoded inside the value),
+// and `opt::option<T>` fits into a single machine word.
+// The option is stored as its object representation inside `std::atomic` of an unsigned integer with the same size
+template<class T>
+class atomic_option {
+    static_assert(!std::is_reference_v<T>, "opt::atomic_option<T> does not support reference types");
+    static_assert(opt::option_traits<T>::max_level > 0,
+        "opt::atomic_option<T> requires opt::option_traits<T> (the size of opt::option<T> must be equal to the size of T)");
+    static_assert(std::is_trivially_copyable_v<T>, "opt::atomic_option<T> requires T to be trivially copyable");
+
+    using word = typename impl::atomic_word_of_size<sizeof(opt::option<T>)>::type;
+    static_assert(!std::is_void_v<word>, "opt::atomic_option<T> requires the size of opt::option<T> to be 1, 2, 4 or 8 bytes");
+
+    std::atomic<word> storage;
+
+    static word to_word(const opt::option<T>& value) noexcept {
+        word result{};
+        std::memcpy(&result, OPTION_ADDRESSOF(value), sizeof(word));
+        return result;
+    }
+    static opt::option<T> from_word(const word value) noexcept {
+        opt::option<T> result;
+        std::memcpy(static_cast<void*>(OPTION_ADDRESSOF(result)), &value, sizeof(word));
+        return result;
+    }
+    static word empty_word() noexcept {
+        return to_word(opt::option<T>{});
+    }
+public:
+    using value_type = opt::option<T>;
+
+    static constexpr bool is_always_lock_free = std::atomic<word>::is_always_lock_free;
+
+    atomic_option() noexcept : storage{empty_word()} {}
+    atomic_option(opt::none_t) noexcept : storage{empty_word()} {}
+    atomic_option(const opt::option<T>& value) noexcept : storage{to_word(value)} {}
+    atomic_option(const T& value) noexcept : storage{to_word(opt::option<T>{value})} {}
+
+    atomic_option(const atomic_option&) = delete;
+    atomic_option& operator=(const atomic_option&) = delete;
+
+    atomic_option& operator=(const opt::option<T>& value) noexcept {
+        store(value);
+        return *this;
+    }
+
+    [[nodiscard]] bool is_lock_free() const noexcept {
+        return storage.is_lock_free();
+    }
+
+    [[nodiscard]] opt::option<T> load(const std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return from_word(storage.load(order));
+    }
+    operator opt::option<T>() const noexcept {
+        return load();
+    }
+
+    [[nodiscard]] bool has_value(const std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        return load(order).has_value();
+    }
+
+    void store(const opt::option<T>& value, const std::memory_order order = std::memory_order_seq_cst) noexcept {
+        storage.store(to_word(value), order);
+    }
+    void reset(const std::memory_order order = std::memory_order_seq_cst) noexcept {
+        storage.store(empty_word(), order);
+    }
+
+    [[nodiscard]] opt::option<T> exchange(const opt::option<T>& value, const std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return from_word(storage.exchange(to_word(value), order));
+    }
+    // Atomically replaces the contained value with an empty state and returns the previous one
+    [[nodiscard]] opt::option<T> take(const std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return from_word(storage.exchange(empty_word(), order));
+    }
+
+    // Compares the object representations of the contained option and `expected`.
+    // If they are equal, replaces the contained option with `desired`; otherwise, loads the contained option into `expected`
+    bool compare_exchange_weak(opt::option<T>& expected, const opt::option<T>& desired,
+        const std::memory_order success, const std::memory_order failure) noexcept {
+        word expected_word = to_word(expected);
+        const bool result = storage.compare_exchange_weak(expected_word, to_word(desired), success, failure);
+        expected = from_word(expected_word);
+        return result;
+    }
+    bool compare_exchange_weak(opt::option<T>& expected, const opt::option<T>& desired,
+        const std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return compare_exchange_weak(expected, desired, order, impl::atomic_failure_order(order));
+    }
+    bool compare_exchange_strong(opt::option<T>& expected, const opt::option<T>& desired,
+        const std::memory_order success, const std::memory_order failure) noexcept {
+        word expected_word = to_word(expected);
+        const bool result = storage.compare_exchange_strong(expected_word, to_word(desired), success, failure);
+        expected = from_word(expected_word);
+        return result;
+    }
+    bool compare_exchange_strong(opt::option<T>& expected, const opt::option<T>& desired,
+        const std::memory_order order = std::memory_order_seq_cst) noexcept {
+        return compare_exchange_strong(expected, desired, order, impl::atomic_failure_order(order));
+    }
+
+    // Atomically stores the value constructed from `args...` if the contained option is empty.
+    // Returns `true` if the value was stored
+    template<class... Args>
+    bool try_emplace(Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        word expected = empty_word();
+        return storage.compare_exchange_strong(expected, to_word(opt::option<T>{T(static_cast<Args&&>(args)...)}));
+    }
+
+#if OPTION_IS_CXX20 && defined(__cpp_lib_atomic_wait)
+    // Blocks until the object representation of the contained option is different from `old`
+    void wait(const opt::option<T>& old, const std::memory_order order = std::memory_order_seq_cst) const noexcept {
+        storage.wait(to_word(old), order);
+    }
+    void notify_one() noexcept {
+        storage.notify_one();
+    }
+    void notify_all() noexcept {
+        storage.notify_all();
+    }
+#endif
+};
+
+}
@@ -0,0 +1,710 @@
+#pragma once
+
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <opt/option.hpp>
+#include <opt/algorithm.hpp>
+#include <memory>
+#include <functional>
+#include <utility>
+#include <iterator>
+#include <initializer_list>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace opt {
+
+namespace impl {
+    // Number of slots that are checked at once when probing
+    inline constexpr std::size_t niche_hash_group_size = 8;
+    inline constexpr std::size_t niche_hash_min_capacity = niche_hash_group_size;
+
+    // Keys, that are equal only if their object representations are equal, are compared using SIMD instructions
+    template<class K, class KeyEqual>
+    constexpr bool niche_hash_use_simd() {
+        if constexpr (std::is_pointer_v<K> || std::is_enum_v<K>) {
+            return !std::is_void_v<typename word_of_size<sizeof(K)>::type>
+                && (std::is_same_v<KeyEqual, std::equal_to<K>> || std::is_same_v<KeyEqual, std::equal_to<>>);
+        } else {
+            return false;
+        }
+    }
+
+    // Open addressing hash table, where the state of each slot is stored inside the key using `opt::option_traits<K>`:
+    // level 0 is an empty slot, level 1 is a tombstone (erased element), any other state is a live key.
+    // The slots are probed linearly in groups of `niche_hash_group_size`.
+    // `V` is `void` for the hash set
+    template<class K, class V, class Hash, class KeyEqual>
+    class niche_hash_table {
+        static_assert(!std::is_reference_v<K> && !std::is_const_v<K>, "The key type must be a non-const object type");
+        static_assert(opt::option_traits<K>::max_level >= 2,
+            "The key type must have at least 2 unused states in opt::option_traits<K> (for the empty and tombstone slots)");
+
+        using traits = opt::option_traits<K>;
+        using mapped = std::conditional_t<std::is_void_v<V>, char, V>;
+
+        static constexpr bool is_map = !std::is_void_v<V>;
+        static constexpr std::size_t group_size = niche_hash_group_size;
+        static constexpr bool use_simd = impl::niche_hash_use_simd<K, KeyEqual>();
+
+        static constexpr std::uintmax_t empty_level = 0;
+        static constexpr std::uintmax_t tombstone_level = 1;
+
+        static bool is_occupied(const K* const key) noexcept {
+            return traits::get_level(key) > tombstone_level;
+        }
+
+        struct buffer {
+            K* keys = nullptr;
+            mapped* values = nullptr;
+            std::size_t capacity = 0;
+
+            buffer() = default;
+
+            void allocate(const std::size_t new_capacity) {
+                keys = std::allocator<K>{}.allocate(new_capacity);
+                capacity = new_capacity;
+                for (std::size_t i = 0; i < capacity; ++i) {
+                    traits::set_level(keys + i, empty_level);
+                }
+                if constexpr (is_map) {
+                    values = std::allocator<mapped>{}.allocate(capacity);
+                }
+            }
+
+            buffer(buffer&& other) noexcept
+                : keys{other.keys}, values{other.values}, capacity{other.capacity} {
+                other.keys = nullptr;
+                other.values = nullptr;
+                other.capacity = 0;
+            }
+            buffer(const buffer&) = delete;
+            buffer& operator=(const buffer&) = delete;
+            buffer& operator=(buffer&&) = delete;
+
+            ~buffer() {
+                if (keys == nullptr) { return; }
+                for (std::size_t i = 0; i < capacity; ++i) {
+                    if (is_occupied(keys + i)) {
+                        keys[i].~K();
+                        if constexpr (is_map) {
+                            values[i].~mapped();
+                        }
+                    }
+                }
+                std::allocator<K>{}.deallocate(keys, capacity);
+                if constexpr (is_map) {
+                    if (values != nullptr) {
+                        std::allocator<mapped>{}.deallocate(values, capacity);
+                    }
+                }
+            }
+
+            void swap(buffer& other) noexcept {
+                std::swap(keys, other.keys);
+                std::swap(values, other.values);
+                std::swap(capacity, other.capacity);
+            }
+
+            // Constructs the key and the value at `index`. If the construction throws, restores the `level` of the slot
+            template<class KeyArg, class... Args>
+            void construct(const std::size_t index, const std::uintmax_t level, KeyArg&& key, Args&&... args) {
+                struct guard {
+                    K* key;
+                    std::uintmax_t level;
+                    bool active = true;
+                    ~guard() {
+                        if (active) { traits::set_level(key, level); }
+                    }
+                };
+                guard key_guard{keys + index, level};
+                impl::construct_at(keys + index, static_cast<KeyArg&&>(key));
+                impl::traits_after_construct<traits>(keys + index);
+                if constexpr (is_map) {
+                    struct value_guard {
+                        K* key;
+                        bool active = true;
+                        ~value_guard() {
+                            if (active) { key->~K(); }
+                        }
+                    };
+                    value_guard destroy_guard{keys + index};
+                    impl::construct_at(values + index, static_cast<Args&&>(args)...);
+                    destroy_guard.active = false;
+                }
+                key_guard.active = false;
+            }
+        };
+
+        buffer slots;
+        std::size_t size_ = 0;
+        std::size_t tombstones = 0;
+        unsigned shift = 64;
+        Hash hasher;
+        KeyEqual key_equal;
+
+        template<std::uintmax_t Level>
+        static auto level_word() noexcept {
+            using word = typename word_of_size<sizeof(K)>::type;
+            K key{};
+            traits::set_level(OPTION_ADDRESSOF(key), Level);
+            word result;
+            std::memcpy(&result, OPTION_ADDRESSOF(key), sizeof(word));
+            return result;
+        }
+
+        // Masks of slots in the group starting at `first` (bit `i` is slot `first + i`)
+        std::uint64_t match_mask(const K* const first, const K& key) const {
+            if constexpr (use_simd) {
+                using word = typename word_of_size<sizeof(K)>::type;
+                word pattern;
+                std::memcpy(&pattern, OPTION_ADDRESSOF(key), sizeof(word));
+                return impl::word_eq_mask<word, group_size>(reinterpret_cast<const unsigned char*>(first), pattern);
+            } else {
+                std::uint64_t mask = 0;
+                for (std::size_t i = 0; i < group_size; ++i) {
+                    if (is_occupied(first + i) && key_equal(first[i], key)) {
+                        mask |= std::uint64_t(1) << i;
+                    }
+                }
+                return mask;
+            }
+        }
+        static std::uint64_t level_mask(const K* const first, const std::uintmax_t max_level) noexcept {
+            std::uint64_t mask = 0;
+            for (std::size_t i = 0; i < group_size; ++i) {
+                mask |= std::uint64_t(traits::get_level(first + i) <= max_level) << i;
+            }
+            return mask;
+        }
+        static std::uint64_t empty_mask(const K* const first) noexcept {
+            if constexpr (use_simd) {
+                using word = typename word_of_size<sizeof(K)>::type;
+                return impl::word_eq_mask<word, group_size>(reinterpret_cast<const unsigned char*>(first), level_word<empty_level>());
+            } else {
+                return level_mask(first, empty_level);
+            }
+        }
+        // Empty or tombstone slots
+        static std::uint64_t available_mask(const K* const first) noexcept {
+            if constexpr (use_simd) {
+                using word = typename word_of_size<sizeof(K)>::type;
+                const auto* const bytes = reinterpret_cast<const unsigned char*>(first);
+                return impl::word_eq_mask<word, group_size>(bytes, level_word<empty_level>())
+                    | impl::word_eq_mask<word, group_size>(bytes, level_word<tombstone_level>());
+            } else {
+                return level_mask(first, tombstone_level);
+            }
+        }
+
+        std::size_t first_group(const K& key) const {
+            // Fibonacci hashing, to spread the bits of the weak hashes (e.g. `std::hash` of pointers)
+            const std::uint64_t hash = std::uint64_t(hasher(key)) * 0x9E3779B97F4A7C15;
+            return std::size_t(hash >> shift) / group_size;
+        }
+
+        static constexpr std::size_t npos = std::size_t(-1);
+
+        std::size_t find_index(const K& key) const {
+            if (size_ == 0) { return npos; }
+
+            const std::size_t group_count = slots.capacity / group_size;
+            std::size_t group = first_group(key);
+            for (std::size_t probe = 0; probe < group_count; ++probe) {
+                const K* const first = slots.keys + group * group_size;
+                const std::uint64_t match = match_mask(first, key);
+                if (match != 0) {
+                    return group * group_size + impl::countr_zero64(match);
+                }
+                if (empty_mask(first) != 0) {
+                    return npos;
+                }
+                group = (group + 1) & (group_count - 1);
+            }
+            return npos;
+        }
+
+        // Returns the index of the key, and `true` if the key was not found
+        // and the slot at the index is available for the construction (`npos` if the table has no slots)
+        std::pair<std::size_t, bool> find_or_prepare(const K& key) const {
+            if (slots.capacity == 0) { return {npos, true}; }
+
+            const std::size_t group_count = slots.capacity / group_size;
+            std::size_t group = first_group(key);
+            std::size_t available = npos;
+            for (std::size_t probe = 0; probe < group_count; ++probe) {
+                const K* const first = slots.keys + group * group_size;
+                const std::uint64_t match = match_mask(first, key);
+                if (match != 0) {
+                    return {group * group_size + impl::countr_zero64(match), false};
+                }
+                if (available == npos) {
+                    const std::uint64_t mask = available_mask(first);
+                    if (mask != 0) {
+                        available = group * group_size + impl::countr_zero64(mask);
+                    }
+                }
+                if (empty_mask(first) != 0) {
+                    break;
+                }
+                group = (group + 1) & (group_count - 1);
+            }
+            OPTION_VERIFY(available != npos, "The hash table must always have an available slot");
+            return {available, true};
+        }
+
+        template<class KeyArg, class... Args>
+        std::pair<std::size_t, bool> emplace_impl(KeyArg&& key, Args&&... args) {
+            auto [index, inserted] = find_or_prepare(key);
+            if (!inserted) {
+                return {index, false};
+            }
+            if ((size_ + tombstones + 1) * 8 > slots.capacity * 7) {
+                // The arguments may refer to the elements of this table,
+                // so the new element is constructed before they are moved from
+                const std::size_t new_capacity = capacity_for(size_ + 1);
+                buffer new_slots;
+                new_slots.allocate(new_capacity);
+                const unsigned new_shift = shift_for(new_capacity);
+                index = empty_slot(new_slots, new_shift, key);
+                new_slots.construct(index, empty_level, static_cast<KeyArg&&>(key), static_cast<Args&&>(args)...);
+                move_into(new_slots, new_shift);
+            } else {
+                const std::uintmax_t level = traits::get_level(slots.keys + index);
+                slots.construct(index, level, static_cast<KeyArg&&>(key), static_cast<Args&&>(args)...);
+                if (level == tombstone_level) {
+                    --tombstones;
+                }
+            }
+            ++size_;
+            return {index, true};
+        }
+
+        static std::size_t capacity_for(const std::size_t count) noexcept {
+            // Keep the load factor at most 1/2 after the rehash
+            std::size_t capacity = niche_hash_min_capacity;
+            while (capacity < count * 2) {
+                capacity *= 2;
+            }
+            return capacity;
+        }
+        static unsigned shift_for(std::size_t capacity) noexcept {
+            unsigned bits = 0;
+            while (capacity > 1) {
+                capacity /= 2;
+                ++bits;
+            }
+            return 64 - bits;
+        }
+
+        // Index of the first empty slot for `key` in `buf` (which has the hash shift `buf_shift`)
+        std::size_t empty_slot(const buffer& buf, const unsigned buf_shift, const K& key) const {
+            const std::uint64_t hash = std::uint64_t(hasher(key)) * 0x9E3779B97F4A7C15;
+            const std::size_t group_count = buf.capacity / group_size;
+            std::size_t group = std::size_t(hash >> buf_shift) / group_size;
+            while (true) {
+                const std::uint64_t mask = empty_mask(buf.keys + group * group_size);
+                if (mask != 0) {
+                    return group * group_size + impl::countr_zero64(mask);
+                }
+                group = (group + 1) & (group_count - 1);
+            }
+        }
+
+        // Moves the elements into `new_slots` and makes it the storage of the table
+        void move_into(buffer& new_slots, const unsigned new_shift) {
+            for (std::size_t i = 0; i < slots.capacity; ++i) {
+                K* const key = slots.keys + i;
+                if (!is_occupied(key)) { continue; }
+
+                const std::size_t index = empty_slot(new_slots, new_shift, *key);
+                if constexpr (is_map) {
+                    new_slots.construct(index, empty_level, std::move_if_noexcept(*key), std::move_if_noexcept(slots.values[i]));
+                } else {
+                    new_slots.construct(index, empty_level, std::move_if_noexcept(*key));
+                }
+            }
+            slots.swap(new_slots);
+            shift = new_shift;
+            tombstones = 0;
+        }
+
+        void rehash(const std::size_t new_capacity) {
+            buffer new_slots;
+            new_slots.allocate(new_capacity);
+            move_into(new_slots, shift_for(new_capacity));
+        }
+
+        void destroy_at(const std::size_t index) noexcept {
+            slots.keys[index].~K();
+            if constexpr (is_map) {
+                slots.values[index].~mapped();
+            }
+        }
+    public:
+        niche_hash_table() = default;
+
+        niche_hash_table(const niche_hash_table& other)
+            : hasher{other.hasher}, key_equal{other.key_equal} {
+            if (other.size_ == 0) { return; }
+            reserve(other.size_);
+            for (std::size_t i = 0; i < other.slots.capacity; ++i) {
+                if (!is_occupied(other.slots.keys + i)) { continue; }
+                if constexpr (is_map) {
+                    emplace_impl(other.slots.keys[i], other.slots.values[i]);
+                } else {
+                    emplace_impl(other.slots.keys[i]);
+                }
+            }
+        }
+        niche_hash_table(niche_hash_table&& other) noexcept
+            : slots{std::move(other.slots)}, size_{other.size_}, tombstones{other.tombstones}, shift{other.shift},
+            hasher{other.hasher}, key_equal{other.key_equal} {
+            other.size_ = 0;
+            other.tombstones = 0;
+            other.shift = 64;
+        }
+        niche_hash_table& operator=(niche_hash_table other) noexcept {
+            swap(other);
+            return *this;
+        }
+        ~niche_hash_table() = default;
+
+        void swap(niche_hash_table& other) noexcept {
+            slots.swap(other.slots);
+            std::swap(size_, other.size_);
+            std::swap(tombstones, other.tombstones);
+            std::swap(shift, other.shift);
+            std::swap(hasher, other.hasher);
+            std::swap(key_equal, other.key_equal);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] std::size_t capacity() const noexcept { return slots.capacity; }
+
+        void reserve(const std::size_t count) {
+            const std::size_t new_capacity = capacity_for(count);
+            if (new_capacity > slots.capacity) {
+                rehash(new_capacity);
+            }
+        }
+        void clear() noexcept {
+            for (std::size_t i = 0; i < slots.capacity; ++i) {
+                K* const key = slots.keys + i;
+                if (is_occupied(key)) {
+                    destroy_at(i);
+                }
+                traits::set_level(key, empty_level);
+            }
+            size_ = 0;
+            tombstones = 0;
+        }
+
+        [[nodiscard]] bool contains(const K& key) const {
+            return find_index(key) != npos;
+        }
+        [[nodiscard]] K* find_key(const K& key) const {
+            const std::size_t index = find_index(key);
+            return index == npos ? nullptr : slots.keys + index;
+        }
+        [[nodiscard]] mapped* find_value(const K& key) const {
+            const std::size_t index = find_index(key);
+            return index == npos ? nullptr : slots.values + index;
+        }
+
+        template<class KeyArg, class... Args>
+        std::pair<mapped*, bool> emplace(KeyArg&& key, Args&&... args) {
+            const auto [index, inserted] = emplace_impl(static_cast<KeyArg&&>(key), static_cast<Args&&>(args)...);
+            if constexpr (is_map) {
+                return {slots.values + index, inserted};
+            } else {
+                return {nullptr, inserted};
+            }
+        }
+
+        bool erase(const K& key) {
+            const std::size_t index = find_index(key);
+            if (index == npos) { return false; }
+            destroy_at(index);
+            traits::set_level(slots.keys + index, tombstone_level);
+            --size_;
+            ++tombstones;
+            return true;
+        }
+        [[nodiscard]] opt::option<mapped> take(const K& key) {
+            const std::size_t index = find_index(key);
+            if (index == npos) { return opt::none; }
+            opt::option<mapped> result{std::move(slots.values[index])};
+            destroy_at(index);
+            traits::set_level(slots.keys + index, tombstone_level);
+            --size_;
+            ++tombstones;
+            return result;
+        }
+
+        // Index of the first occupied slot starting from `index`, or the capacity
+        [[nodiscard]] std::size_t next_occupied(std::size_t index) const noexcept {
+            while (index < slots.capacity && !is_occupied(slots.keys + index)) {
+                ++index;
+            }
+            return index;
+        }
+        [[nodiscard]] K* key_at(const std::size_t index) const noexcept { return slots.keys + index; }
+        [[nodiscard]] mapped* value_at(const std::size_t index) const noexcept { return slots.values + index; }
+    };
+
+    template<class Table, bool IsConst>
+    class niche_hash_map_iterator {
+        using key_type = std::remove_pointer_t<decltype(std::declval<const Table&>().key_at(0))>;
+        using mapped_type = std::remove_pointer_t<decltype(std::declval<const Table&>().value_at(0))>;
+
+        const Table* table = nullptr;
+        std::size_t index = 0;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = std::pair<const key_type, mapped_type>;
+        using reference = std::pair<const key_type&, std::conditional_t<IsConst, const mapped_type&, mapped_type&>>;
+        using pointer = void;
+
+        niche_hash_map_iterator() = default;
+        niche_hash_map_iterator(const Table* table_, const std::size_t index_) noexcept
+            : table{table_}, index{table_->next_occupied(index_)} {}
+
+        template<bool OtherConst, std::enable_if_t<IsConst && !OtherConst, int> = 0>
+        niche_hash_map_iterator(const niche_hash_map_iterator<Table, OtherConst>& other) noexcept
+            : table{other.table}, index{other.index} {}
+
+        [[nodiscard]] reference operator*() const noexcept {
+            return reference{*table->key_at(index), *table->value_at(index)};
+        }
+        niche_hash_map_iterator& operator++() noexcept {
+            index = table->next_occupied(index + 1);
+            return *this;
+        }
+        niche_hash_map_iterator operator++(int) noexcept {
+            niche_hash_map_iterator copy{*this};
+            ++*this;
+            return copy;
+        }
+        [[nodiscard]] friend bool operator==(const niche_hash_map_iterator& left, const niche_hash_map_iterator& right) noexcept {
+            return left.index == right.index;
+        }
+        [[nodiscard]] friend bool operator!=(const niche_hash_map_iterator& left, const niche_hash_map_iterator& right) noexcept {
+            return left.index != right.index;
+        }
+
+        template<class, bool>
+        friend class niche_hash_map_iterator;
+    };
+
+    template<class Table>
+    class niche_hash_set_iterator {
+        using key_type = std::remove_pointer_t<decltype(std::declval<const Table&>().key_at(0))>;
+
+        const Table* table = nullptr;
+        std::size_t index = 0;
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = key_type;
+        using reference = const key_type&;
+        using pointer = const key_type*;
+
+        niche_hash_set_iterator() = default;
+        niche_hash_set_iterator(const Table* table_, const std::size_t index_) noexcept
+            : table{table_}, index{table_->next_occupied(index_)} {}
+
+        [[nodiscard]] reference operator*() const noexcept { return *table->key_at(index); }
+        [[nodiscard]] pointer operator->() const noexcept { return table->key_at(index); }
+        niche_hash_set_iterator& operator++() noexcept {
+            index = table->next_occupied(index + 1);
+            return *this;
+        }
+        niche_hash_set_iterator operator++(int) noexcept {
+            niche_hash_set_iterator copy{*this};
+            ++*this;
+            return copy;
+        }
+        [[nodiscard]] friend bool operator==(const niche_hash_set_iterator& left, const niche_hash_set_iterator& right) noexcept {
+            return left.index == right.index;
+        }
+        [[nodiscard]] friend bool operator!=(const niche_hash_set_iterator& left, const niche_hash_set_iterator& right) noexcept {
+            return left.index != right.index;
+        }
+    };
+}
+
+// Open addressing hash map that stores the state of each slot (empty/erased/occupied) inside the key using `opt::option_traits<K>`
+template<class K, class V, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class niche_hash_map {
+    using table_type = impl::niche_hash_table<K, V, Hash, KeyEqual>;
+
+    table_type table;
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using iterator = impl::niche_hash_map_iterator<table_type, false>;
+    using const_iterator = impl::niche_hash_map_iterator<table_type, true>;
+
+    niche_hash_map() = default;
+
+    explicit niche_hash_map(const size_type count) {
+        reserve(count);
+    }
+    niche_hash_map(const std::initializer_list<std::pair<K, V>> ilist) {
+        reserve(ilist.size());
+        for (const std::pair<K, V>& x : ilist) {
+            try_emplace(x.first, x.second);
+        }
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return table.size(); }
+    [[nodiscard]] bool empty() const noexcept { return table.size() == 0; }
+    // Number of slots
+    [[nodiscard]] size_type capacity() const noexcept { return table.capacity(); }
+
+    // Reserves space for at least `count` elements without a rehash
+    void reserve(const size_type count) { table.reserve(count); }
+    void clear() noexcept { table.clear(); }
+
+    [[nodiscard]] iterator begin() noexcept { return iterator{&table, 0}; }
+    [[nodiscard]] iterator end() noexcept { return iterator{&table, table.capacity()}; }
+    [[nodiscard]] const_iterator begin() const noexcept { return const_iterator{&table, 0}; }
+    [[nodiscard]] const_iterator end() const noexcept { return const_iterator{&table, table.capacity()}; }
+
+    // Returns a reference option to the value mapped to `key`, or an empty option if there is no such key
+    [[nodiscard]] opt::option<V&> find(const K& key) OPTION_LIFETIMEBOUND {
+        V* const value = table.find_value(key);
+        return value == nullptr ? opt::option<V&>{} : opt::option<V&>{*value};
+    }
+    [[nodiscard]] opt::option<const V&> find(const K& key) const OPTION_LIFETIMEBOUND {
+        const V* const value = table.find_value(key);
+        return value == nullptr ? opt::option<const V&>{} : opt::option<const V&>{*value};
+    }
+    [[nodiscard]] bool contains(const K& key) const {
+        return table.contains(key);
+    }
+
+    // Inserts the value constructed from `args...` if there is no element with `key`.
+    // Returns a reference to the value mapped to `key`, and `true` if the insertion took place
+    template<class... Args>
+    std::pair<V&, bool> try_emplace(const K& key, Args&&... args) OPTION_LIFETIMEBOUND {
+        const auto [value, inserted] = table.emplace(key, static_cast<Args&&>(args)...);
+        return {*value, inserted};
+    }
+    template<class... Args>
+    std::pair<V&, bool> try_emplace(K&& key, Args&&... args) OPTION_LIFETIMEBOUND {
+        const auto [value, inserted] = table.emplace(static_cast<K&&>(key), static_cast<Args&&>(args)...);
+        return {*value, inserted};
+    }
+    template<class U>
+    bool insert_or_assign(const K& key, U&& value) {
+        const auto [slot, inserted] = table.emplace(key, static_cast<U&&>(value));
+        if (!inserted) {
+            *slot = static_cast<U&&>(value);
+        }
+        return inserted;
+    }
+
+    V& operator[](const K& key) OPTION_LIFETIMEBOUND {
+        return *table.emplace(key).first;
+    }
+    V& operator[](K&& key) OPTION_LIFETIMEBOUND {
+        return *table.emplace(static_cast<K&&>(key)).first;
+    }
+
+    // Removes the element with `key`. Returns `true` if the element was removed
+    bool erase(const K& key) {
+        return table.erase(key);
+    }
+    // Removes the element with `key` and returns its value, or an empty option if there is no such key
+    [[nodiscard]] opt::option<V> take(const K& key) {
+        return table.take(key);
+    }
+
+    void swap(niche_hash_map& other) noexcept {
+        table.swap(other.table);
+    }
+    friend void swap(niche_hash_map& left, niche_hash_map& right) noexcept {
+        left.swap(right);
+    }
+};
+
+// Open addressing hash set that stores the state of each slot (empty/erased/occupied) inside the key using `opt::option_traits<K>`
+template<class K, class Hash = std::hash<K>, class KeyEqual = std::equal_to<K>>
+class niche_hash_set {
+    using table_type = impl::niche_hash_table<K, void, Hash, KeyEqual>;
+
+    table_type table;
+public:
+    using key_type = K;
+    using value_type = K;
+    using size_type = std::size_t;
+    using hasher = Hash;
+    using key_equal = KeyEqual;
+    using iterator = impl::niche_hash_set_iterator<table_type>;
+    using const_iterator = iterator;
+
+    niche_hash_set() = default;
+
+    explicit niche_hash_set(const size_type count) {
+        reserve(count);
+    }
+    niche_hash_set(const std::initializer_list<K> ilist) {
+        reserve(ilist.size());
+        for (const K& x : ilist) {
+            insert(x);
+        }
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return table.size(); }
+    [[nodiscard]] bool empty() const noexcept { return table.size() == 0; }
+    // Number of slots
+    [[nodiscard]] size_type capacity() const noexcept { return table.capacity(); }
+
+    // Reserves space for at least `count` elements without a rehash
+    void reserve(const size_type count) { table.reserve(count); }
+    void clear() noexcept { table.clear(); }
+
+    [[nodiscard]] iterator begin() const noexcept { return iterator{&table, 0}; }
+    [[nodiscard]] iterator end() const noexcept { return iterator{&table, table.capacity()}; }
+
+    // Returns a reference option to the stored key equal to `key`, or an empty option if there is no such key
+    [[nodiscard]] opt::option<const K&> find(const K& key) const OPTION_LIFETIMEBOUND {
+        const K* const found = table.find_key(key);
+        return found == nullptr ? opt::option<const K&>{} : opt::option<const K&>{*found};
+    }
+    [[nodiscard]] bool contains(const K& key) const {
+        return table.contains(key);
+    }
+
+    // Returns `true` if the insertion took place
+    bool insert(const K& key) {
+        return table.emplace(key).second;
+    }
+    bool insert(K&& key) {
+        return table.emplace(static_cast<K&&>(key)).second;
+    }
+
+    // Removes the element equal to `key`. Returns `true` if the element was removed
+    bool erase(const K& key) {
+        return table.erase(key);
+    }
+
+    void swap(niche_hash_set& other) noexcept {
+        table.swap(other.table);
+    }
+    friend void swap(niche_hash_set& left, niche_hash_set& right) noexcept {
+        left.swap(right);
+    }
+};
+
+}
@@ -0,0 +1,429 @@
+#pragma once
+
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <opt/option.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <type_traits>
+#include <tuple>
+
+namespace opt {
+
+template<class... Ts>
+class niche_variant;
+
+namespace impl {
+    inline constexpr std::size_t niche_variant_npos = std::size_t(-1);
+
+    // Returns the index of the alternative, that stores the discriminant in its unused states (levels of `opt::option_traits`),
+    // or `niche_variant_npos` if the discriminant is stored separately.
+    // The discriminant can be stored in the alternative if it is the only non-empty alternative
+    // and has enough levels for all the other (empty) alternatives
+    template<class... Ts>
+    constexpr std::size_t niche_variant_carrier() {
+        constexpr std::size_t count = sizeof...(Ts);
+        constexpr bool empties[]{std::is_empty_v<Ts>...};
+        constexpr std::uintmax_t levels[]{opt::option_traits<Ts>::max_level...};
+
+        std::size_t carrier = niche_variant_npos;
+        for (std::size_t i = 0; i < count; ++i) {
+            if (empties[i]) { continue; }
+            if (carrier != niche_variant_npos) {
+                return niche_variant_npos;
+            }
+            carrier = i;
+        }
+        if (carrier == niche_variant_npos || levels[carrier] < count - 1) {
+            return niche_variant_npos;
+        }
+        return carrier;
+    }
+
+    template<bool TriviallyDestructible, class... Ts>
+    union niche_variant_union;
+
+    template<bool TriviallyDestructible>
+    union niche_variant_union<TriviallyDestructible> {
+        char dummy;
+    };
+    template<class T, class... Ts>
+    union niche_variant_union<true, T, Ts...> {
+        T first;
+        niche_variant_union<true, Ts...> rest;
+
+        constexpr niche_variant_union() noexcept : rest{} {}
+    };
+    template<class T, class... Ts>
+    union niche_variant_union<false, T, Ts...> {
+        T first;
+        niche_variant_union<false, Ts...> rest;
+
+        niche_variant_union() noexcept : rest{} {}
+        ~niche_variant_union() {}
+    };
+
+    template<std::size_t I, class Union>
+    constexpr auto* niche_variant_get(Union& storage) noexcept {
+        if constexpr (I == 0) {
+            return OPTION_ADDRESSOF(storage.first);
+        } else {
+            return impl::niche_variant_get<I - 1>(storage.rest);
+        }
+    }
+
+    template<class T, class... Ts>
+    constexpr std::size_t niche_variant_type_index() {
+        constexpr bool same[]{std::is_same_v<T, Ts>...};
+        std::size_t result = niche_variant_npos;
+        for (std::size_t i = 0; i < sizeof...(Ts); ++i) {
+            if (same[i]) {
+                if (result != niche_variant_npos) {
+                    return niche_variant_npos;
+                }
+                result = i;
+            }
+        }
+        return result;
+    }
+}
+
+// Sum type (like `std::variant`), that stores the discriminant in the unused states (levels of `opt::option_traits`)
+// of the only non-empty alternative, if there are enough of them.
+// Otherwise, the discriminant is stored in a separate byte.
+// Never valueless: all alternatives must be nothrow move constructible
+template<class... Ts>
+class niche_variant {
+    static_assert(sizeof...(Ts) > 0, "opt::niche_variant must have at least one alternative");
+    static_assert(sizeof...(Ts) < 256, "opt::niche_variant must have less than 256 alternatives");
+    static_assert(((!std::is_reference_v<Ts> && !std::is_array_v<Ts> && !std::is_void_v<Ts>) && ...),
+        "opt::niche_variant alternatives must be object types");
+    static_assert((std::is_nothrow_move_constructible_v<Ts> && ...),
+        "opt::niche_variant alternatives must be nothrow move constructible");
+
+    template<class, class>
+    friend struct opt::option_traits;
+
+    static constexpr std::size_t count = sizeof...(Ts);
+    static constexpr std::size_t carrier = impl::niche_variant_carrier<Ts...>();
+    static constexpr bool trivially_destructible = (std::is_trivially_destructible_v<Ts> && ...);
+
+    template<std::size_t I>
+    using alternative = std::tuple_element_t<I, std::tuple<Ts...>>;
+public:
+    // `true` if the discriminant is stored inside the alternative, and the size of `opt::niche_variant` is equal to the size of it
+    static constexpr bool is_niche_packed = carrier != impl::niche_variant_npos;
+private:
+    using carrier_type = std::conditional_t<is_niche_packed, alternative<(is_niche_packed ? carrier : 0)>, void>;
+    using carrier_traits = opt::option_traits<std::conditional_t<is_niche_packed, carrier_type, char>>;
+
+    struct packed_storage {
+        impl::niche_variant_union<trivially_destructible, Ts...> values;
+    };
+    struct separate_storage {
+        impl::niche_variant_union<trivially_destructible, Ts...> values;
+        std::uint8_t index;
+    };
+    std::conditional_t<is_niche_packed, packed_storage, separate_storage> storage;
+
+    template<std::size_t I>
+    auto* ptr() noexcept {
+        return impl::niche_variant_get<I>(storage.values);
+    }
+    template<std::size_t I>
+    const auto* ptr() const noexcept {
+        return impl::niche_variant_get<I>(storage.values);
+    }
+
+    // Level of the carrier alternative, that indicates that the alternative `I` is active
+    template<std::size_t I>
+    static constexpr std::uintmax_t level_of = I < carrier ? I : I - 1;
+
+    template<std::size_t I>
+    void set_index() noexcept {
+        if constexpr (is_niche_packed) {
+            if constexpr (I != carrier) {
+                carrier_traits::set_level(ptr<carrier>(), level_of<I>);
+            }
+        } else {
+            storage.index = std::uint8_t(I);
+        }
+    }
+
+    template<std::size_t I = 0, class Fn>
+    decltype(auto) dispatch(Fn&& fn) const {
+        if constexpr (I + 1 == count) {
+            return fn(std::integral_constant<std::size_t, I>{});
+        } else {
+            if (index() == I) {
+                return fn(std::integral_constant<std::size_t, I>{});
+            }
+            return dispatch<I + 1>(static_cast<Fn&&>(fn));
+        }
+    }
+
+    template<std::size_t I, class... Args>
+    void construct(Args&&... args) {
+        impl::construct_at(ptr<I>(), static_cast<Args&&>(args)...);
+        if constexpr (is_niche_packed && I == carrier) {
+            impl::traits_after_construct<carrier_traits>(ptr<carrier>());
+        }
+        // Set after the construction, since the construction of an empty alternative may overwrite the carrier's bits
+        set_index<I>();
+        if constexpr (is_niche_packed && I == carrier) {
+            OPTION_VERIFY(carrier_traits::get_level(ptr<carrier>()) >= count - 1,
+                "After the construction, the carrier alternative is in one of its unused states");
+        }
+    }
+
+    void destroy() noexcept {
+        if constexpr (!trivially_destructible) {
+            dispatch([&](auto i) {
+                using T = alternative<decltype(i)::value>;
+                ptr<decltype(i)::value>()->~T();
+            });
+        }
+    }
+
+    template<class Other>
+    void construct_from(Other&& other) {
+        other.dispatch([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            impl::construct_at(ptr<I>(), static_cast<Other&&>(other).template get<I>());
+            if constexpr (is_niche_packed && I == carrier) {
+                impl::traits_after_construct<carrier_traits>(ptr<carrier>());
+            }
+            set_index<I>();
+        });
+    }
+    // Assigns to the active alternative `I`
+    template<std::size_t I, class U>
+    void assign(U&& value) {
+        *ptr<I>() = static_cast<U&&>(value);
+        if constexpr (is_niche_packed && I == carrier) {
+            impl::traits_after_construct<carrier_traits>(ptr<carrier>());
+        }
+        set_index<I>();
+    }
+
+    template<class Other>
+    void assign_from(Other&& other) {
+        other.dispatch([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            if (index() == I) {
+                assign<I>(static_cast<Other&&>(other).template get<I>());
+            } else {
+                emplace<I>(static_cast<Other&&>(other).template get<I>());
+            }
+        });
+    }
+public:
+    // Default constructs the first alternative
+    niche_variant() noexcept(std::is_nothrow_default_constructible_v<alternative<0>>) {
+        construct<0>();
+    }
+
+    template<std::size_t I, class... Args>
+    explicit niche_variant(std::in_place_index_t<I>, Args&&... args) {
+        construct<I>(static_cast<Args&&>(args)...);
+    }
+    template<class T, class... Args>
+    explicit niche_variant(std::in_place_type_t<T>, Args&&... args) {
+        constexpr std::size_t I = impl::niche_variant_type_index<T, Ts...>();
+        static_assert(I != impl::niche_variant_npos, "T must occur exactly once in the alternatives");
+        construct<I>(static_cast<Args&&>(args)...);
+    }
+    // Constructs the alternative with the same type as `U` (without cv-qualifiers and references)
+    template<class U, class T = impl::remove_cvref<U>,
+        std::enable_if_t<impl::niche_variant_type_index<T, Ts...>() != impl::niche_variant_npos, int> = 0>
+    niche_variant(U&& value) {
+        construct<impl::niche_variant_type_index<T, Ts...>()>(static_cast<U&&>(value));
+    }
+
+    niche_variant(const niche_variant& other) {
+        construct_from(other);
+    }
+    niche_variant(niche_variant&& other) noexcept {
+        construct_from(static_cast<niche_variant&&>(other));
+    }
+    niche_variant& operator=(const niche_variant& other) {
+        assign_from(other);
+        return *this;
+    }
+    niche_variant& operator=(niche_variant&& other) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...)) {
+        assign_from(static_cast<niche_variant&&>(other));
+        return *this;
+    }
+    template<class U, class T = impl::remove_cvref<U>,
+        std::enable_if_t<impl::niche_variant_type_index<T, Ts...>() != impl::niche_variant_npos, int> = 0>
+    niche_variant& operator=(U&& value) {
+        constexpr std::size_t I = impl::niche_variant_type_index<T, Ts...>();
+        if (index() == I) {
+            assign<I>(static_cast<U&&>(value));
+        } else {
+            emplace<I>(static_cast<U&&>(value));
+        }
+        return *this;
+    }
+
+    ~niche_variant() {
+        destroy();
+    }
+
+    // Zero-based index of the active alternative
+    [[nodiscard]] std::size_t index() const noexcept {
+        if constexpr (is_niche_packed) {
+            const std::uintmax_t level = carrier_traits::get_level(ptr<carrier>());
+            if (level >= count - 1) {
+                return carrier;
+            }
+            return std::size_t(level < carrier ? level : level + 1);
+        } else {
+            return storage.index;
+        }
+    }
+
+    template<class T>
+    [[nodiscard]] bool holds_alternative() const noexcept {
+        constexpr std::size_t I = impl::niche_variant_type_index<T, Ts...>();
+        static_assert(I != impl::niche_variant_npos, "T must occur exactly once in the alternatives");
+        return index() == I;
+    }
+
+    template<std::size_t I, class... Args>
+    alternative<I>& emplace(Args&&... args) OPTION_LIFETIMEBOUND {
+        using T = alternative<I>;
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+            destroy();
+            construct<I>(static_cast<Args&&>(args)...);
+        } else {
+            // Construct a temporary first, so the variant is not left without a value when the constructor throws
+            T temp(static_cast<Args&&>(args)...);
+            destroy();
+            construct<I>(static_cast<T&&>(temp));
+        }
+        return *ptr<I>();
+    }
+    template<class T, class... Args>
+    T& emplace(Args&&... args) OPTION_LIFETIMEBOUND {
+        constexpr std::size_t I = impl::niche_variant_type_index<T, Ts...>();
+        static_assert(I != impl::niche_variant_npos, "T must occur exactly once in the alternatives");
+        return emplace<I>(static_cast<Args&&>(args)...);
+    }
+
+    template<std::size_t I>
+    [[nodiscard]] alternative<I>& get() & noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(index() == I, "Accessing an inactive alternative");
+        return *ptr<I>();
+    }
+    template<std::size_t I>
+    [[nodiscard]] const alternative<I>& get() const& noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(index() == I, "Accessing an inactive alternative");
+        return *ptr<I>();
+    }
+    template<std::size_t I>
+    [[nodiscard]] alternative<I>&& get() && noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(index() == I, "Accessing an inactive alternative");
+        return static_cast<alternative<I>&&>(*ptr<I>());
+    }
+    template<class T>
+    [[nodiscard]] T& get() & noexcept OPTION_LIFETIMEBOUND {
+        return get<impl::niche_variant_type_index<T, Ts...>()>();
+    }
+    template<class T>
+    [[nodiscard]] const T& get() const& noexcept OPTION_LIFETIMEBOUND {
+        return get<impl::niche_variant_type_index<T, Ts...>()>();
+    }
+
+    // Returns a reference option to the alternative `I` if it's active; otherwise, an empty option
+    template<std::size_t I>
+    [[nodiscard]] opt::option<alternative<I>&> get_if() noexcept OPTION_LIFETIMEBOUND {
+        if (index() == I) {
+            return opt::option<alternative<I>&>{*ptr<I>()};
+        }
+        return opt::none;
+    }
+    template<std::size_t I>
+    [[nodiscard]] opt::option<const alternative<I>&> get_if() const noexcept OPTION_LIFETIMEBOUND {
+        if (index() == I) {
+            return opt::option<const alternative<I>&>{*ptr<I>()};
+        }
+        return opt::none;
+    }
+    template<class T>
+    [[nodiscard]] opt::option<T&> get_if() noexcept OPTION_LIFETIMEBOUND {
+        return get_if<impl::niche_variant_type_index<T, Ts...>()>();
+    }
+    template<class T>
+    [[nodiscard]] opt::option<const T&> get_if() const noexcept OPTION_LIFETIMEBOUND {
+        return get_if<impl::niche_variant_type_index<T, Ts...>()>();
+    }
+
+    // Calls `fn` with the active alternative
+    template<class Fn>
+    decltype(auto) visit(Fn&& fn) & {
+        return dispatch([&](auto i) -> decltype(auto) { return fn(get<decltype(i)::value>()); });
+    }
+    template<class Fn>
+    decltype(auto) visit(Fn&& fn) const& {
+        return dispatch([&](auto i) -> decltype(auto) { return fn(get<decltype(i)::value>()); });
+    }
+    template<class Fn>
+    decltype(auto) visit(Fn&& fn) && {
+        return dispatch([&](auto i) -> decltype(auto) { return fn(static_cast<niche_variant&&>(*this).template get<decltype(i)::value>()); });
+    }
+
+    void swap(niche_variant& other) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...)) {
+        niche_variant temp{static_cast<niche_variant&&>(other)};
+        other = static_cast<niche_variant&&>(*this);
+        *this = static_cast<niche_variant&&>(temp);
+    }
+    friend void swap(niche_variant& left, niche_variant& right) noexcept(noexcept(left.swap(right))) {
+        left.swap(right);
+    }
+
+    [[nodiscard]] friend bool operator==(const niche_variant& left, const niche_variant& right) {
+        if (left.index() != right.index()) {
+            return false;
+        }
+        return left.dispatch([&](auto i) {
+            return bool(left.template get<decltype(i)::value>() == right.template get<decltype(i)::value>());
+        });
+    }
+    [[nodiscard]] friend bool operator!=(const niche_variant& left, const niche_variant& right) {
+        return !(left == right);
+    }
+};
+
+template<class... Ts>
+struct option_traits<niche_variant<Ts...>> {
+private:
+    using variant = niche_variant<Ts...>;
+public:
+    // The levels of the carrier alternative after the ones, that are used for the discriminant.
+    // Or the values of the separate discriminant byte, that are greater than or equal to the alternative count
+    static constexpr std::uintmax_t max_level = variant::is_niche_packed
+        ? variant::carrier_traits::max_level - (variant::count - 1)
+        : 256 - variant::count;
+
+    static std::uintmax_t get_level(const variant* const value) noexcept {
+        if constexpr (variant::is_niche_packed) {
+            return variant::carrier_traits::get_level(value->template ptr<variant::carrier>()) - (variant::count - 1);
+        } else {
+            return std::uint8_t(value->storage.index - variant::count);
+        }
+    }
+    static void set_level(variant* const value, const std::uintmax_t level) noexcept {
+        OPTION_VERIFY(level < max_level, "Level is out of range");
+        if constexpr (variant::is_niche_packed) {
+            variant::carrier_traits::set_level(value->template ptr<variant::carrier>(), level + (variant::count - 1));
+        } else {
+            value->storage.index = std::uint8_t(level + variant::count);
+        }
+    }
+};
+
+}
@@ -272,6 +272,18 @@
     #define OPTION_CAN_REFLECT_ENUM 0
 #endif
 
+#ifndef OPTION_USE_NONCANONICAL_POINTERS
+    #if defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64)
+        #define OPTION_USE_NONCANONICAL_POINTERS 1
+    #else
+        #define OPTION_USE_NONCANONICAL_POINTERS 0
+    #endif
+#endif
+
+#ifndef OPTION_USE_CHRONO_MIN_SENTINEL
+    #define OPTION_USE_CHRONO_MIN_SENTINEL 0
+#endif
+
 #ifndef OPTION_CONSUMED_ANNOTATION_CHECKING
     #define OPTION_CONSUMED_ANNOTATION_CHECKING 0
 #endif
@@ -347,12 +359,42 @@ OPTION_STD_NAMESPACE_CXX11_END
     template<class T>
     struct default_delete; // Defined in header <memory>
 
+    template<class T>
+    class shared_ptr; // Defined in header <memory>
+
+    template<class T>
+    class weak_ptr; // Defined in header <memory>
+
     template<class T, size_t N>
     struct array; // Defined in header <array>
 
     template<class... Types>
     class variant; // Defined in header <variant>
 
+    template<class T>
+    class optional; // Defined in header <optional>
+
+#if OPTION_IS_CXX20
+    template<class T, size_t Extent>
+    class span; // Defined in header <span>
+#endif
+
+    namespace chrono {
+#if OPTION_LIBSTDCPP
+        template<class Rep, class Period>
+        struct duration; // Defined in header <chrono>
+
+        template<class Clock, class Duration>
+        struct time_point; // Defined in header <chrono>
+#else
+        template<class Rep, class Period>
+        class duration; // Defined in header <chrono>
+
+        template<class Clock, class Duration>
+        class time_point; // Defined in header <chrono>
+#endif
+    }
+
 #if OPTION_MSVC
     #pragma push_macro("_EXPORT_STD")
     #ifndef _EXPORT_STD
@@ -495,7 +537,12 @@ OPTION_STD_NAMESPACE_END
     #include <memory>
     #include <array>
     #include <variant>
+    #include <optional>
     #include <complex>
+    #include <chrono>
+    #if OPTION_IS_CXX20
+        #include <span>
+    #endif
 #endif
 
 #if OPTION_IS_CXX20
@@ -679,6 +726,30 @@ namespace impl {
     inline constexpr bool has_set_level_method<T, Traits, decltype(Traits::set_level(std::declval<std::remove_const_t<T>*>(), std::declval<std::uintmax_t>()))>
         = noexcept(Traits::set_level(std::declval<std::remove_const_t<T>*>(), std::declval<std::uintmax_t>()));
 
+    template<class T, class Traits, class = void>
+    inline constexpr bool has_after_construct_method = false;
+    template<class T, class Traits>
+    inline constexpr bool has_after_construct_method<T, Traits, decltype(Traits::after_construct(std::declval<std::remove_const_t<T>*>()))>
+        = noexcept(Traits::after_construct(std::declval<std::remove_const_t<T>*>()));
+
+    // Calls the optional `after_construct` static method of the option traits, that prepares the unused bytes of a newly constructed value.
+    // Also called after `opt::option` assigns to the contained value
+    template<class Traits, class T>
+    constexpr void traits_after_construct(T* const value) noexcept {
+        if constexpr (has_after_construct_method<T, Traits>) {
+            Traits::after_construct(value);
+        }
+    }
+
+    template<class T, class Traits, class = void>
+    inline constexpr bool has_empty_representation = false;
+    // The optional `empty_representation` static member of the option traits is the object representation of `T` with the level 0,
+    // as an unsigned integer of the same size
+    template<class T, class Traits>
+    inline constexpr bool has_empty_representation<T, Traits, decltype(Traits::empty_representation, void())>
+        = std::is_unsigned_v<std::remove_const_t<decltype(Traits::empty_representation)>>
+        && sizeof(Traits::empty_representation) == sizeof(T);
+
     template<class T, class = void>
     inline constexpr bool has_padding_member = false;
     template<class T>
@@ -755,6 +826,16 @@ namespace impl {
     template<bool Condition, class If, class Else>
     using if_ = typename if_impl<Condition>::template type<If, Else>;
 
+#if !OPTION_UNKNOWN_STD
+    // libstdc++, libc++ and MSVC STL store the "engaged" flag of `std::optional<T>` as `bool` right after the storage of the value
+    template<class T>
+    struct std_optional_layout {
+        static constexpr std::size_t engaged_offset = sizeof(T);
+
+        static_assert(sizeof(std::optional<T>) >= engaged_offset + sizeof(bool));
+    };
+#endif
+
 #if OPTION_USE_BUILTIN_TRAITS
 
 #if OPTION_CLANG
@@ -812,6 +893,13 @@ namespace impl {
         }
         return idx;
     }
+    constexpr std::size_t max_of(const std::initializer_list<std::size_t> values) noexcept {
+        std::size_t result = 0;
+        for (const std::size_t value : values) {
+            result = value > result ? value : result;
+        }
+        return result;
+    }
 
     template<class... Traits>
     struct find_max_level {
@@ -840,9 +928,80 @@ namespace impl {
     template<class... Ts>
     struct pfr_find_max_level<std::tuple<Ts&...>>
         : find_max_level<opt::option_traits<Ts>...> {};
+
+    template<class T>
+    struct pfr_members {
+        template<std::size_t I>
+        using traits = opt::option_traits<OPTION_PFR_NAMESPACE tuple_element_t<I, T>>;
+
+        template<std::size_t I, class U>
+        static constexpr auto* get(U* const value) noexcept { return OPTION_ADDRESSOF(OPTION_PFR_NAMESPACE get<I>(*value)); }
+    };
+
+    struct padding_run {
+        std::size_t offset;
+        std::size_t size;
+    };
+    // Finds the longest run of padding bytes (between the members or after the last one),
+    // assuming the members are laid out in declaration order
+    constexpr padding_run find_padding_run(const std::initializer_list<std::size_t> sizes, const std::initializer_list<std::size_t> alignments,
+        const std::size_t struct_size, const std::size_t struct_alignment) noexcept {
+        padding_run result{0, 0};
+        std::size_t end = 0;
+        const std::size_t* alignment = alignments.begin();
+        for (const std::size_t size : sizes) {
+            const std::size_t offset = (end + *alignment - 1) / *alignment * *alignment;
+            if (offset - end > result.size) {
+                result = {end, offset - end};
+            }
+            end = offset + size;
+            ++alignment;
+        }
+        // The layout doesn't match the computed one
+        if ((end + struct_alignment - 1) / struct_alignment * struct_alignment != struct_size) {
+            return {0, 0};
+        }
+        if (struct_size - end > result.size) {
+            result = {end, struct_size - end};
+        }
+        return result;
+    }
+
+    template<class T, class = std::make_index_sequence<OPTION_PFR_NAMESPACE tuple_size_v<T>>>
+    struct pfr_padding_layout;
+    template<class T, std::size_t... Is>
+    struct pfr_padding_layout<T, std::index_sequence<Is...>> {
+    private:
+        static constexpr padding_run run = find_padding_run(
+            {sizeof(OPTION_PFR_NAMESPACE tuple_element_t<Is, T>)...},
+            {alignof(OPTION_PFR_NAMESPACE tuple_element_t<Is, T>)...},
+            sizeof(T), alignof(T)
+        );
+    public:
+        static constexpr std::size_t offset = run.offset;
+        // Uses at most 8 bytes
+        static constexpr std::size_t size = run.size < 8 ? run.size : 8;
+    };
+
+    template<class T>
+    inline constexpr bool pfr_has_padding_niche = [] {
+        if constexpr (std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>) {
+            return pfr_padding_layout<T>::size >= 4;
+        } else {
+            return false;
+        }
+    }();
 #endif
 
 #if OPTION_CAN_REFLECT_ENUM
+    constexpr std::size_t decimal_digits(std::uintmax_t value) noexcept {
+        std::size_t result = 1;
+        for (; value >= 10; value /= 10) {
+            result += 1;
+        }
+        return result;
+    }
+
     template<auto... Enumerators>
     constexpr std::uintmax_t max_enum_value_impl2(const std::uintmax_t max) {
         const char* const name = OPTION_CURRENT_FUNCTION();
@@ -878,21 +1037,38 @@ namespace impl {
     #endif
         }
 #else
-        std::size_t start = 0;
-        while (name[start] != '{') {
-            start += 1;
-        }
-        if (name[start + 1] != '(') { return 0; }
+        // The enumerators are in the ascending order: {(E)0, (E)1, ..., (E)N}, where `N` is `max - 1`.
+        // Values without enumerator are printed as '(E)N'.
+        // Instead of scanning every character, the entries are inspected from the end,
+        // where the position of each entry is computed from the length of the '(E)' prefix and the number of digits
+        std::size_t end = __builtin_strlen(name);
+        while (name[end] != '}') {
+            end -= 1;
+        }
+        if (name[end - 1] < '0' || name[end - 1] > '9') { return 0; }
+
+        // Find the '(' that matches the ')' before the digits of the last entry
+        std::size_t prefix_start = end - decimal_digits(max - 1) - 1;
+        if (name[prefix_start] != ')') { return 0; }
+        for (std::size_t depth = 1; depth != 0;) {
+            prefix_start -= 1;
+            depth += name[prefix_start] == ')' ? 1 : 0;
+            depth -= name[prefix_start] == '(' ? 1 : 0;
+        }
+        const std::size_t prefix_size = end - decimal_digits(max - 1) - prefix_start;
 
         std::uintmax_t current = max;
-        for (std::size_t i = start + 1;;) {
+        for (;;) {
+            const std::uintmax_t value = current - 1;
+            // The entry is '(E)N' only if ')' is followed by a digit (identifiers can't start with a digit)
+            const std::size_t digits_start = end - decimal_digits(value);
+            if (name[digits_start - 1] != ')' || name[digits_start] < '0' || name[digits_start] > '9') { break; }
+
             current -= 1;
-            for (; name[i] != ','; ++i) {
-                if (name[i] == '}') { return 0; }
-            }
-            i += 2; // skip whitespace
-            if (name[i] != '(') { break; }
+            if (current == 0) { return 0; }
+            end = digits_start - prefix_size - 2; // skip ', '
         }
+        if (current == max) { return 0; }
 #endif
         // https://graphics.stanford.edu/%7Eseander/bithacks.html#RoundUpPowerOf2
         // Round up to the next highest power of 2
@@ -910,7 +1086,12 @@ namespace impl {
 
     template<class E, std::uintmax_t Max, class T, T... Vals>
     constexpr std::uintmax_t max_enum_value_impl1(std::integer_sequence<T, Vals...>) {
+#if OPTION_GCC
+        // Avoids instantiating the `Max - 1 - Vals` expression for every value
+        return max_enum_value_impl2<static_cast<E>(Vals)...>(Max);
+#else
         return max_enum_value_impl2<static_cast<E>(Max - 1 - Vals)...>(Max);
+#endif
     }
     template<class E, std::uintmax_t Max>
     constexpr std::uintmax_t max_enum_value() {
@@ -951,6 +1132,113 @@ namespace impl {
         return tuple_like_get_impl::call<I>(x, 1);
     }
 
+    // If a single member has at least this number of levels, only that member is used to store the level value
+    inline constexpr std::uintmax_t combine_levels_limit = 0x10000;
+    // Maximum number of the elements of `std::array`, that are used to combine levels
+    inline constexpr std::size_t combine_levels_max_elements = 8;
+
+    template<std::size_t N>
+    struct combined_levels_info {
+        bool selected[N]{};
+        std::uintmax_t max_level = 1;
+        bool enabled = false;
+    };
+    template<std::size_t N>
+    constexpr combined_levels_info<N> select_combined_levels(const std::uintmax_t (&levels)[N]) noexcept {
+        combined_levels_info<N> info{};
+        std::uintmax_t best = 0;
+        for (const std::uintmax_t level : levels) {
+            best = level > best ? level : best;
+        }
+        if (best >= combine_levels_limit) {
+            return info;
+        }
+        std::size_t count = 0;
+        for (std::size_t i = 0; i < N; ++i) {
+            // Skip members that does not add any levels, and those that would overflow the product
+            if (levels[i] < 2 || info.max_level > std::uintmax_t(-1) / levels[i]) { continue; }
+            info.max_level *= levels[i];
+            info.selected[i] = true;
+            ++count;
+        }
+        info.enabled = count >= 2;
+        return info;
+    }
+
+    // Combines levels of several members in mixed radix form: the level value of each selected member is a digit
+    // with the base equal to its `max_level` (the first selected member is the least significant digit).
+    // `Members` provides `traits<I>` (the option traits of the member `I`) and `get<I>(value)` (the pointer to the member `I`)
+    template<class Members, class IndexSequence>
+    struct combined_levels;
+
+    template<class Members>
+    struct combined_levels<Members, std::index_sequence<>> {
+        static constexpr bool enabled = false;
+        static constexpr std::uintmax_t max_level = 0;
+    };
+
+    template<class Members, std::size_t... Is>
+    struct combined_levels<Members, std::index_sequence<Is...>> {
+    private:
+        static constexpr std::uintmax_t levels[]{Members::template traits<Is>::max_level...};
+        static constexpr combined_levels_info<sizeof...(Is)> info = select_combined_levels(levels);
+
+        template<std::size_t I, class T>
+        static constexpr bool get_digit(const T* const value, std::uintmax_t& level, std::uintmax_t& base) noexcept {
+            if constexpr (info.selected[I]) {
+                using traits = typename Members::template traits<I>;
+                const std::uintmax_t digit = traits::get_level(Members::template get<I>(value));
+                // Contains a value
+                if (digit >= traits::max_level) { return false; }
+                level += digit * base;
+                base *= traits::max_level;
+            }
+            return true;
+        }
+        template<std::size_t I, class T>
+        static constexpr void set_digit(T* const value, std::uintmax_t& level) noexcept {
+            if constexpr (info.selected[I]) {
+                using traits = typename Members::template traits<I>;
+                traits::set_level(Members::template get<I>(value), level % traits::max_level);
+                level /= traits::max_level;
+            }
+        }
+    public:
+        static constexpr bool enabled = info.enabled;
+        static constexpr std::uintmax_t max_level = info.max_level;
+
+        template<class T>
+        static constexpr std::uintmax_t get_level(const T* const value) noexcept {
+            std::uintmax_t level = 0;
+            std::uintmax_t base = 1;
+            const bool is_empty = (get_digit<Is>(value, level, base) && ...);
+            return is_empty ? level : std::uintmax_t(-1);
+        }
+        template<class T>
+        static constexpr void set_level(T* const value, std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            (set_digit<Is>(value, level), ...);
+        }
+    };
+
+    // Members of `std::pair`, `std::tuple` and `std::array`
+    template<class T>
+    struct std_get_members {
+        template<std::size_t I>
+        using traits = opt::option_traits<std::remove_reference_t<decltype(std::get<I>(std::declval<T&>()))>>;
+
+        template<std::size_t I, class U>
+        static constexpr auto* get(U* const value) noexcept { return OPTION_ADDRESSOF(std::get<I>(*value)); }
+    };
+    template<class T>
+    struct tuple_like_members {
+        template<std::size_t I>
+        using traits = opt::option_traits<std::tuple_element_t<I, T>>;
+
+        template<std::size_t I, class U>
+        static constexpr auto* get(U* const value) noexcept { return OPTION_ADDRESSOF(tuple_like_get<I>(*value)); }
+    };
+
     enum class option_strategy {
         none,
         other,
@@ -963,6 +1251,9 @@ namespace impl {
         unavaliable_option,
         reference_option,
         pointer_64,
+#if OPTION_USE_NONCANONICAL_POINTERS
+        pointer_64_noncanonical,
+#endif
         pointer_32,
         float64_sNaN,
         float64_qNaN,
@@ -970,9 +1261,21 @@ namespace impl {
         float32_qNaN,
         polymorphic,
         string_view,
+#if OPTION_IS_CXX20
+        span,
+#endif
+        char32,
+        chrono_duration,
+        chrono_duration_min,
+        chrono_time_point,
 #if !OPTION_UNKNOWN_STD
         string,
         vector,
+        std_optional,
+        shared_ptr,
+#endif
+#if OPTION_LIBSTDCPP || OPTION_LIBCPP
+        variant,
 #endif
         unique_ptr,
         member_pointer_32,
@@ -988,6 +1291,7 @@ namespace impl {
         complex,
 #ifdef OPTION_HAS_PFR
         reflectable,
+        padding_bytes,
 #endif
     };
 
@@ -1014,6 +1318,10 @@ namespace impl {
     struct dispatch_specializations<bool> {
         static constexpr option_strategy value = option_strategy::bool_;
     };
+    template<>
+    struct dispatch_specializations<char32_t> {
+        static constexpr option_strategy value = option_strategy::char32;
+    };
     template<class T>
     struct dispatch_specializations<std::reference_wrapper<T>> {
         static constexpr option_strategy value = option_strategy::reference_wrapper;
@@ -1034,6 +1342,24 @@ namespace impl {
     struct dispatch_specializations<std::basic_string_view<Elem, Traits>> {
         static constexpr option_strategy value = option_strategy::string_view;
     };
+#if OPTION_IS_CXX20
+    template<class Elem, std::size_t Extent>
+    struct dispatch_specializations<std::span<Elem, Extent>> {
+        static constexpr option_strategy value = option_strategy::span;
+    };
+#endif
+    template<class Rep, class Period>
+    struct dispatch_specializations<std::chrono::duration<Rep, Period>> {
+        static constexpr bool min_sentinel = OPTION_USE_CHRONO_MIN_SENTINEL && std::is_integral_v<Rep> && std::is_signed_v<Rep>;
+        static constexpr option_strategy value = opt::option_traits<Rep>::max_level > 0
+            ? option_strategy::chrono_duration
+            : (min_sentinel ? option_strategy::chrono_duration_min : option_strategy::none);
+    };
+    template<class Clock, class Duration>
+    struct dispatch_specializations<std::chrono::time_point<Clock, Duration>> {
+        static constexpr option_strategy value = opt::option_traits<Duration>::max_level > 0
+            ? option_strategy::chrono_time_point : option_strategy::none;
+    };
 #if !OPTION_UNKNOWN_STD
     template<class Elem, class Traits, class Allocator>
     struct dispatch_specializations<std::basic_string<Elem, Traits, Allocator>> {
@@ -1045,6 +1371,24 @@ namespace impl {
         static constexpr bool ebo_allocator = std::is_empty_v<Allocator> && !std::is_final_v<Allocator>;
         static constexpr option_strategy value = ebo_allocator ? option_strategy::vector : option_strategy::none;
     };
+    template<class T>
+    struct dispatch_specializations<std::optional<T>> {
+        static constexpr option_strategy value = option_strategy::std_optional;
+    };
+    template<class T>
+    struct dispatch_specializations<std::shared_ptr<T>> {
+        static constexpr option_strategy value = option_strategy::shared_ptr;
+    };
+    template<class T>
+    struct dispatch_specializations<std::weak_ptr<T>> {
+        static constexpr option_strategy value = option_strategy::shared_ptr;
+    };
+#endif
+#if OPTION_LIBSTDCPP || OPTION_LIBCPP
+    template<class... Ts>
+    struct dispatch_specializations<std::variant<Ts...>> {
+        static constexpr option_strategy value = option_strategy::variant;
+    };
 #endif
     template<class Elem>
     struct dispatch_specializations<std::unique_ptr<Elem, std::default_delete<Elem>>> {
@@ -1065,7 +1409,11 @@ namespace impl {
         } else
         if constexpr (std::is_pointer_v<T>) {
             if constexpr (sizeof(T) == 8) {
+#if OPTION_USE_NONCANONICAL_POINTERS
+                return st::pointer_64_noncanonical;
+#else
                 return st::pointer_64;
+#endif
             } else
             if constexpr (sizeof(T) == 4) {
                 return st::pointer_32;    
@@ -1158,6 +1506,7 @@ namespace impl {
         using uint_bool = std::uint_least8_t;
     public:
         static constexpr std::uintmax_t max_level = 254;
+        static constexpr uint_bool empty_representation = 2;
 
         static std::uintmax_t get_level(const bool* const value) noexcept {
             return uint_bool(impl::ptr_bit_cast<uint_bool>(value) - 2);
@@ -1171,6 +1520,7 @@ namespace impl {
     template<class T>
     struct internal_option_traits<std::reference_wrapper<T>, option_strategy::reference_wrapper> {
         static constexpr std::uintmax_t max_level = 256;
+        static constexpr std::uintptr_t empty_representation = 0;
 
         static std::uintmax_t get_level(const std::reference_wrapper<T>* const value) noexcept {
             const std::uintptr_t ptr = impl::ptr_bit_cast<std::uintptr_t>(value);
@@ -1187,6 +1537,7 @@ namespace impl {
         static constexpr std::uint64_t ptr_offset = 0xF8E1B1825D5D6C67;
     public:
         static constexpr std::uintmax_t max_level = 512;
+        static constexpr std::uint64_t empty_representation = ptr_offset;
 
         static std::uintmax_t get_level(const T* const value) noexcept {
             const std::uint64_t uint = impl::ptr_bit_cast<std::uint64_t>(value);
@@ -1197,12 +1548,42 @@ namespace impl {
             impl::ptr_bit_copy(value, std::uint64_t(ptr_offset + level));
         }
     };
+#if OPTION_USE_NONCANONICAL_POINTERS
+    // Uses the non-canonical addresses, that can't be valid pointers on x86-64 and AArch64.
+    // x86-64: any address with the 63rd bit set, that is not a kernel address (the top byte is not 0xFF),
+    // is non-canonical with 4 and 5 level paging (and with the linear address masking).
+    // AArch64: the bits [48, 55] of the range are neither all zeros nor all ones (the top byte is ignored)
+    template<class T>
+    struct internal_option_traits<T, option_strategy::pointer_64_noncanonical> {
+    private:
+        // The same offset as in `pointer_64`, so the empty state has the same representation
+        static constexpr std::uint64_t ptr_offset = 0xF8E1B1825D5D6C67;
+    #if defined(__aarch64__) || defined(_M_ARM64)
+        static constexpr std::uint64_t ptr_end = 0xF8EF'FFFF'FFFF'FFFF;
+    #else
+        static constexpr std::uint64_t ptr_end = 0xFEFF'FFFF'FFFF'FFFF;
+    #endif
+    public:
+        static constexpr std::uintmax_t max_level = ptr_end - ptr_offset + 1;
+        static constexpr std::uint64_t empty_representation = ptr_offset;
+
+        static std::uintmax_t get_level(const T* const value) noexcept {
+            const std::uint64_t uint = impl::ptr_bit_cast<std::uint64_t>(value);
+            return uint - ptr_offset;
+        }
+        static void set_level(T* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            impl::ptr_bit_copy(value, std::uint64_t(ptr_offset + level));
+        }
+    };
+#endif
     template<class T>
     struct internal_option_traits<T, option_strategy::pointer_32> {
     private:
         static constexpr std::uint32_t ptr_offset = 0xFFFF'FFFFUL - 63;
     public:
         static constexpr std::uintmax_t max_level = 32;
+        static constexpr std::uint32_t empty_representation = ptr_offset;
 
         static std::uintmax_t get_level(const T* const value) noexcept {
             const std::uint32_t uint = impl::ptr_bit_cast<std::uint32_t>(value);
@@ -1219,6 +1600,7 @@ namespace impl {
         static constexpr std::uint64_t nan_start = 0b1'11111111111'0110110001111001111101010101101100001000100110001111;
     public:
         static constexpr std::uintmax_t max_level = 256;
+        static constexpr std::uint64_t empty_representation = nan_start;
 
         static std::uintmax_t get_level(const T* const value) noexcept {
             const std::uint64_t uint = impl::ptr_bit_cast<std::uint64_t>(value);
@@ -1235,6 +1617,7 @@ namespace impl {
         static constexpr std::uint64_t nan_start = 0b1'11111111111'1011111100100110010000110000101110110011010101010111;
     public:
         static constexpr std::uintmax_t max_level = 256;
+        static constexpr std::uint64_t empty_representation = nan_start;
 
         static std::uintmax_t get_level(const T* const value) noexcept {
             const std::uint64_t uint = impl::ptr_bit_cast<std::uint64_t>(value);
@@ -1251,6 +1634,7 @@ namespace impl {
         static constexpr std::uint32_t nan_start = 0b1'11111111'01111110110100110101111u;
     public:
         static constexpr std::uintmax_t max_level = 256;
+        static constexpr std::uint32_t empty_representation = nan_start;
 
         static std::uintmax_t get_level(const T* const value) noexcept {
             const std::uint32_t uint = impl::ptr_bit_cast<std::uint32_t>(value);
@@ -1267,6 +1651,7 @@ namespace impl {
         static constexpr std::uint32_t nan_start = 0b1'11111111'10000111110111110110101u;
     public:
         static constexpr std::uintmax_t max_level = 256;
+        static constexpr std::uint32_t empty_representation = nan_start;
 
         static std::uintmax_t get_level(const T* const value) noexcept {
             const std::uint32_t uint = impl::ptr_bit_cast<std::uint32_t>(value);
@@ -1291,10 +1676,15 @@ namespace impl {
 
         using selected = if_<first_is_max, selected_first, selected_second>;
         using traits = typename selected::traits;
+
+        using combined = combined_levels<std_get_members<std::pair<First, Second>>, std::index_sequence<0, 1>>;
     public:
-        static constexpr std::uintmax_t max_level = traits::max_level;
+        static constexpr std::uintmax_t max_level = combined::enabled ? combined::max_level : traits::max_level;
 
         static constexpr std::uintmax_t get_level(const std::pair<First, Second>* const value) noexcept {
+            if constexpr (combined::enabled) {
+                return combined::get_level(value);
+            } else
             if constexpr (first_is_max) {
                 return traits::get_level(OPTION_ADDRESSOF(value->first));
             } else {
@@ -1302,6 +1692,9 @@ namespace impl {
             }
         }
         static constexpr void set_level(std::pair<First, Second>* const value, const std::uintmax_t level) noexcept {
+            if constexpr (combined::enabled) {
+                combined::set_level(value, level);
+            } else
             if constexpr (first_is_max) {
                 traits::set_level(OPTION_ADDRESSOF(value->first), level);
             } else {
@@ -1315,14 +1708,24 @@ namespace impl {
         using find_result = find_max_level<opt::option_traits<Ts>...>;
 
         static constexpr std::size_t tuple_index = find_result::index;
+
+        using combined = combined_levels<std_get_members<std::tuple<Ts...>>, std::index_sequence_for<Ts...>>;
     public:
-        static constexpr std::uintmax_t max_level = find_result::type::max_level;
+        static constexpr std::uintmax_t max_level = combined::enabled ? combined::max_level : find_result::type::max_level;
 
         static constexpr std::uintmax_t get_level(const std::tuple<Ts...>* const value) noexcept {
-            return find_result::type::get_level(OPTION_ADDRESSOF(std::get<tuple_index>(*value)));
+            if constexpr (combined::enabled) {
+                return combined::get_level(value);
+            } else {
+                return find_result::type::get_level(OPTION_ADDRESSOF(std::get<tuple_index>(*value)));
+            }
         }
         static constexpr void set_level(std::tuple<Ts...>* const value, const std::uintmax_t level) noexcept {
-            find_result::type::set_level(OPTION_ADDRESSOF(std::get<tuple_index>(*value)), level);
+            if constexpr (combined::enabled) {
+                combined::set_level(value, level);
+            } else {
+                find_result::type::set_level(OPTION_ADDRESSOF(std::get<tuple_index>(*value)), level);
+            }
         }
     };
 
@@ -1330,14 +1733,25 @@ namespace impl {
     struct internal_option_traits<std::array<T, N>, option_strategy::array> {
     private:
         using traits = opt::option_traits<T>;
+
+        using combined = combined_levels<std_get_members<std::array<T, N>>,
+            std::make_index_sequence<(N < combine_levels_max_elements ? N : combine_levels_max_elements)>>;
     public:
-        static constexpr std::uintmax_t max_level = traits::max_level;
+        static constexpr std::uintmax_t max_level = combined::enabled ? combined::max_level : traits::max_level;
 
         static constexpr std::uintmax_t get_level(const std::array<T, N>* const value) noexcept {
-            return traits::get_level(OPTION_ADDRESSOF((*value)[0]));
+            if constexpr (combined::enabled) {
+                return combined::get_level(value);
+            } else {
+                return traits::get_level(OPTION_ADDRESSOF((*value)[0]));
+            }
         }
         static constexpr void set_level(std::array<T, N>* const value, const std::uintmax_t level) noexcept {
-            traits::set_level(OPTION_ADDRESSOF((*value)[0]), level);
+            if constexpr (combined::enabled) {
+                combined::set_level(value, level);
+            } else {
+                traits::set_level(OPTION_ADDRESSOF((*value)[0]), level);
+            }
         }
     };
 
@@ -1349,14 +1763,60 @@ namespace impl {
             decltype(OPTION_PFR_NAMESPACE structure_tie(std::declval<T&>()))
         >;
         static constexpr std::size_t index = find_result::index;
+
+        using combined = combined_levels<pfr_members<T>, std::make_index_sequence<OPTION_PFR_NAMESPACE tuple_size_v<T>>>;
     public:
-        static constexpr std::uintmax_t max_level = find_result::type::max_level;
+        static constexpr std::uintmax_t max_level = combined::enabled ? combined::max_level : find_result::type::max_level;
 
         static constexpr std::uintmax_t get_level(const T* const value) noexcept {
-            return find_result::type::get_level(OPTION_ADDRESSOF(OPTION_PFR_NAMESPACE get<index>(*value)));
+            if constexpr (combined::enabled) {
+                return combined::get_level(value);
+            } else {
+                return find_result::type::get_level(OPTION_ADDRESSOF(OPTION_PFR_NAMESPACE get<index>(*value)));
+            }
         }
         static constexpr void set_level(T* const value, const std::uintmax_t level) noexcept {
-            find_result::type::set_level(OPTION_ADDRESSOF(OPTION_PFR_NAMESPACE get<index>(*value)), level);
+            if constexpr (combined::enabled) {
+                combined::set_level(value, level);
+            } else {
+                find_result::type::set_level(OPTION_ADDRESSOF(OPTION_PFR_NAMESPACE get<index>(*value)), level);
+            }
+        }
+    };
+    template<class T>
+    struct internal_option_traits<T, option_strategy::padding_bytes> {
+    private:
+        using layout = pfr_padding_layout<T>;
+
+        // The first padding byte stores the level, the rest are filled with the magic bytes
+        static constexpr unsigned char magic[7]{0x5A, 0x3C, 0x9E, 0x17, 0xB2, 0xD4, 0x6F};
+        static constexpr std::size_t magic_size = layout::size - 1;
+
+        static const unsigned char* padding(const T* const value) noexcept {
+            return reinterpret_cast<const unsigned char*>(value) + layout::offset;
+        }
+        static unsigned char* padding(T* const value) noexcept {
+            return reinterpret_cast<unsigned char*>(value) + layout::offset;
+        }
+    public:
+        static constexpr std::uintmax_t max_level = 256;
+
+        static std::uintmax_t get_level(const T* const value) noexcept {
+            const unsigned char* const bytes = padding(value);
+            if (std::memcmp(bytes + 1, magic, magic_size) != 0) {
+                return std::uintmax_t(-1);
+            }
+            return bytes[0];
+        }
+        static void set_level(T* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            unsigned char* const bytes = padding(value);
+            bytes[0] = static_cast<unsigned char>(level);
+            std::memcpy(bytes + 1, magic, magic_size);
+        }
+        // The padding bytes of a newly constructed or assigned value are unspecified (they may contain the magic bytes)
+        static void after_construct(T* const value) noexcept {
+            std::memset(padding(value), 0, layout::size);
         }
     };
 #endif // defined(OPTION_HAS_PFR)
@@ -1394,6 +1854,96 @@ namespace impl {
             impl::construct_at(value, ptr, std::size_t(0));
         }
     };
+#if OPTION_IS_CXX20
+    template<class Elem, std::size_t Extent>
+    struct internal_option_traits<std::span<Elem, Extent>, option_strategy::span> {
+    private:
+        static constexpr std::uintptr_t sentinel_ptr = std::uintptr_t(-1) - 58214;
+        // `std::dynamic_extent`
+        static constexpr std::size_t size = (Extent == std::size_t(-1)) ? 0 : Extent;
+    public:
+        static constexpr std::uintmax_t max_level = 255;
+
+        static std::uintmax_t get_level(const std::span<Elem, Extent>* const value) noexcept {
+            const std::uintptr_t uint_ptr = reinterpret_cast<std::uintptr_t>(value->data());
+            return uint_ptr - sentinel_ptr;
+        }
+        static void set_level(std::span<Elem, Extent>* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            Elem* const ptr = reinterpret_cast<Elem*>(sentinel_ptr + level);
+            impl::construct_at(value, ptr, size);
+        }
+    };
+#endif
+    template<>
+    struct internal_option_traits<char32_t, option_strategy::char32> {
+    private:
+        // The values after the last Unicode code point (U+10FFFF)
+        static constexpr std::uint_least32_t first_level = 0x110000;
+    public:
+        static constexpr std::uintmax_t max_level = std::uintmax_t(0xFFFFFFFF) - first_level + 1;
+
+        static std::uintmax_t get_level(const char32_t* const value) noexcept {
+            return std::uint_least32_t(std::uint_least32_t(*value) - first_level);
+        }
+        static void set_level(char32_t* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            *value = char32_t(first_level + level);
+        }
+    };
+    template<class Rep, class Period>
+    struct internal_option_traits<std::chrono::duration<Rep, Period>, option_strategy::chrono_duration> {
+    private:
+        using rep_traits = opt::option_traits<Rep>;
+    public:
+        static constexpr std::uintmax_t max_level = rep_traits::max_level;
+
+        static std::uintmax_t get_level(const std::chrono::duration<Rep, Period>* const value) noexcept {
+            const Rep count = value->count();
+            return rep_traits::get_level(OPTION_ADDRESSOF(count));
+        }
+        static void set_level(std::chrono::duration<Rep, Period>* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            Rep count{};
+            rep_traits::set_level(OPTION_ADDRESSOF(count), level);
+            impl::construct_at(value, count);
+        }
+    };
+    template<class Rep, class Period>
+    struct internal_option_traits<std::chrono::duration<Rep, Period>, option_strategy::chrono_duration_min> {
+    private:
+        using urep = std::make_unsigned_t<Rep>;
+        static constexpr urep min_value = urep(std::numeric_limits<Rep>::min());
+    public:
+        static constexpr std::uintmax_t max_level = 256;
+
+        static std::uintmax_t get_level(const std::chrono::duration<Rep, Period>* const value) noexcept {
+            return urep(urep(value->count()) - min_value);
+        }
+        static void set_level(std::chrono::duration<Rep, Period>* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            impl::construct_at(value, Rep(min_value + level));
+        }
+    };
+    template<class Clock, class Duration>
+    struct internal_option_traits<std::chrono::time_point<Clock, Duration>, option_strategy::chrono_time_point> {
+    private:
+        using duration_traits = opt::option_traits<Duration>;
+    public:
+        static constexpr std::uintmax_t max_level = duration_traits::max_level;
+
+        static std::uintmax_t get_level(const std::chrono::time_point<Clock, Duration>* const value) noexcept {
+            const Duration duration = value->time_since_epoch();
+            return duration_traits::get_level(OPTION_ADDRESSOF(duration));
+        }
+        static void set_level(std::chrono::time_point<Clock, Duration>* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            Duration duration{};
+            duration_traits::set_level(OPTION_ADDRESSOF(duration), level);
+            impl::construct_at(value, duration);
+        }
+    };
+
     template<class Elem>
     struct internal_option_traits<std::unique_ptr<Elem, std::default_delete<Elem>>, option_strategy::unique_ptr> {
     private:
@@ -1521,13 +2071,16 @@ namespace impl {
 //        by a constant expression', set the compiler option -fconstexpr-steps=N to a higher value.
 // GCC:   If you have 'error: `constexpr` loop iteration count exceeds limit of XXX',
 //        set the compiler option -fconstexpr-loop-limit=N to a higher value.
+// Or specialize opt::enumeration_option_traits<T> to specify the largest enumerator explicitly.
 // #################################################################################################
-        static constexpr std::uintmax_t max_enumerator_value = impl::max_enum_value<T, probe_value>();
-
         using underlying = std::underlying_type_t<T>;
     public:
+        // Enumerators are assumed to be in the range [0, max_enumerator_value)
+        static constexpr std::uintmax_t max_enumerator_value = impl::max_enum_value<T, probe_value>();
+
         static constexpr std::uintmax_t max_level =
             max_enumerator_value == 0 ? 0 : probe_value - max_enumerator_value;
+        static constexpr std::make_unsigned_t<underlying> empty_representation = std::make_unsigned_t<underlying>(max_enumerator_value);
 
         static constexpr std::uintmax_t get_level(const T* const value) noexcept {
             const underlying uint = impl::ptr_bit_cast<underlying>(value);
@@ -1547,6 +2100,7 @@ namespace impl {
         static constexpr T sentinel_value = T::SENTINEL;
     public:
         static constexpr std::uintmax_t max_level = 1;
+        static constexpr std::make_unsigned_t<underlying> empty_representation = std::make_unsigned_t<underlying>(sentinel_value);
 
         static constexpr std::uintmax_t get_level(const T* const value) noexcept {
             return std::uintmax_t(underlying(*value) - underlying(sentinel_value));
@@ -1564,6 +2118,7 @@ namespace impl {
     public:
         static constexpr std::uintmax_t max_level
             = (std::numeric_limits<underlying>::max)() - std::uintmax_t(sentinel_range_start) + 1;
+        static constexpr std::make_unsigned_t<underlying> empty_representation = std::make_unsigned_t<underlying>(sentinel_range_start);
 
         static constexpr std::uintmax_t get_level(const T* const value) noexcept {
             const underlying val = impl::ptr_bit_cast<underlying>(value);
@@ -1582,6 +2137,7 @@ namespace impl {
         static constexpr underlying sentinel_range_end = static_cast<underlying>(T::SENTINEL_END);
     public:
         static constexpr std::uintmax_t max_level = sentinel_range_end - sentinel_range_start + 1;
+        static constexpr std::make_unsigned_t<underlying> empty_representation = std::make_unsigned_t<underlying>(sentinel_range_start);
 
         static constexpr std::uintmax_t get_level(const T* const value) noexcept {
             const underlying val = impl::ptr_bit_cast<underlying>(value);
@@ -1599,14 +2155,24 @@ namespace impl {
         using find_result = tuple_like_find_max_level<T>;
 
         static constexpr std::size_t index = find_result::index;
+
+        using combined = combined_levels<tuple_like_members<T>, std::make_index_sequence<std::tuple_size<T>::value>>;
     public:
-        static constexpr std::uintmax_t max_level = find_result::type::max_level;
+        static constexpr std::uintmax_t max_level = combined::enabled ? combined::max_level : find_result::type::max_level;
 
         static constexpr std::uintmax_t get_level(const T* const value) noexcept {
-            return find_result::type::get_level(OPTION_ADDRESSOF(tuple_like_get<index>(*value)));
+            if constexpr (combined::enabled) {
+                return combined::get_level(value);
+            } else {
+                return find_result::type::get_level(OPTION_ADDRESSOF(tuple_like_get<index>(*value)));
+            }
         }
         static constexpr void set_level(T* const value, const std::uintmax_t level) noexcept {
-            find_result::type::set_level(OPTION_ADDRESSOF(tuple_like_get<index>(*value)), level);
+            if constexpr (combined::enabled) {
+                combined::set_level(value, level);
+            } else {
+                find_result::type::set_level(OPTION_ADDRESSOF(tuple_like_get<index>(*value)), level);
+            }
         }
     };
 
@@ -1727,7 +2293,99 @@ namespace impl {
             std::memcpy(reinterpret_cast<std::uint8_t*>(value) + 0, &first, ptr_size);
         }
     };
+    template<class T>
+    struct internal_option_traits<std::optional<T>, option_strategy::std_optional> {
+    private:
+        using uint_bool = std::uint_least8_t;
+        static constexpr std::size_t engaged_offset = std_optional_layout<T>::engaged_offset;
+    public:
+        static constexpr std::uintmax_t max_level = 254;
+
+        static std::uintmax_t get_level(const std::optional<T>* const value) noexcept {
+            uint_bool engaged{};
+            std::memcpy(&engaged, reinterpret_cast<const std::uint8_t*>(value) + engaged_offset, sizeof(uint_bool));
+            return uint_bool(engaged - 2);
+        }
+        static void set_level(std::optional<T>* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            const uint_bool engaged = uint_bool(level + 2);
+            std::memcpy(reinterpret_cast<std::uint8_t*>(value) + engaged_offset, &engaged, sizeof(uint_bool));
+        }
+    };
+    // `std::shared_ptr` and `std::weak_ptr`
+    template<class T>
+    struct internal_option_traits<T, option_strategy::shared_ptr> {
+    private:
+        using ptr_type = typename T::element_type*;
+        using ptr_traits = opt::option_traits<ptr_type>;
+
+        // The stored pointer, then the pointer to the control block
+        static constexpr std::size_t ptr_offset = 0;
+        static constexpr std::size_t control_offset = sizeof(void*);
+        static_assert(sizeof(T) == 2 * sizeof(void*));
+    public:
+        static constexpr std::uintmax_t max_level = ptr_traits::max_level;
+
+        static std::uintmax_t get_level(const T* const value) noexcept {
+            const void* control{};
+            std::memcpy(&control, reinterpret_cast<const std::uint8_t*>(value) + control_offset, sizeof(void*));
+            // A pointer with a control block is never empty. Without one (a null pointer, or the aliasing constructor
+            // with an empty owner), the level is decided by the option traits of the stored pointer
+            if (control != nullptr) {
+                return std::uintmax_t(-1);
+            }
+            ptr_type ptr{};
+            std::memcpy(&ptr, reinterpret_cast<const std::uint8_t*>(value) + ptr_offset, sizeof(ptr_type));
+            return ptr_traits::get_level(OPTION_ADDRESSOF(ptr));
+        }
+        static void set_level(T* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            ptr_type ptr{};
+            ptr_traits::set_level(OPTION_ADDRESSOF(ptr), level);
+            std::memcpy(reinterpret_cast<std::uint8_t*>(value) + ptr_offset, &ptr, sizeof(ptr_type));
+            const void* const control = nullptr;
+            std::memcpy(reinterpret_cast<std::uint8_t*>(value) + control_offset, &control, sizeof(void*));
+        }
+    };
 #endif // !OPTION_UNKNOWN_STD
+#if OPTION_LIBSTDCPP || OPTION_LIBCPP
+    template<class... Ts>
+    struct internal_option_traits<std::variant<Ts...>, option_strategy::variant> {
+    private:
+        static constexpr std::size_t count = sizeof...(Ts);
+    #if OPTION_LIBSTDCPP
+        using index_t = std::conditional_t<(count <= 0xFF), unsigned char, unsigned short>;
+    #elif defined(_LIBCPP_ABI_VARIANT_INDEX_TYPE_OPTIMIZATION)
+        using index_t = std::conditional_t<(count < 0xFF), unsigned char,
+            std::conditional_t<(count < 0xFFFF), unsigned short, unsigned int>>;
+    #else
+        using index_t = unsigned int;
+    #endif
+        static constexpr std::size_t round_up(const std::size_t value, const std::size_t alignment) noexcept {
+            return (value + alignment - 1) / alignment * alignment;
+        }
+        static constexpr std::size_t storage_align = impl::max_of({alignof(Ts)...});
+        static constexpr std::size_t storage_size = round_up(impl::max_of({sizeof(Ts)...}), storage_align);
+        // The index is placed right after the union of the alternatives
+        static constexpr std::size_t index_offset = round_up(storage_size, alignof(index_t));
+
+        static_assert(sizeof(std::variant<Ts...>) == round_up(index_offset + sizeof(index_t), impl::max_of({storage_align, alignof(index_t)})));
+    public:
+        // Index values in [sizeof...(Ts), variant_npos) are never used
+        static constexpr std::uintmax_t max_level = std::uintmax_t(index_t(-1)) - count;
+
+        static std::uintmax_t get_level(const std::variant<Ts...>* const value) noexcept {
+            index_t index{};
+            std::memcpy(&index, reinterpret_cast<const std::uint8_t*>(value) + index_offset, sizeof(index_t));
+            return index_t(index - count);
+        }
+        static void set_level(std::variant<Ts...>* const value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < max_level, "Level is out of range");
+            const index_t index = index_t(level + count);
+            std::memcpy(reinterpret_cast<std::uint8_t*>(value) + index_offset, &index, sizeof(index_t));
+        }
+    };
+#endif
 
     template<class T>
     struct internal_option_traits<std::complex<T>, option_strategy::complex> {
@@ -1767,6 +2425,17 @@ struct option_traits {
 };
 #endif
 
+#if OPTION_USE_BUILTIN_TRAITS && defined(OPTION_HAS_PFR)
+// Stores the level inside the padding bytes of a reflectable aggregate.
+// Never selected automatically, since assigning to the contained value directly may copy stale padding bytes.
+// Opt in with `template<> struct opt::option_traits<T> : opt::padding_option_traits<T> {};`
+template<class T>
+struct padding_option_traits : impl::internal_option_traits<T, impl::option_strategy::padding_bytes> {
+    static_assert(impl::pfr_has_padding_niche<T>,
+        "opt::padding_option_traits requires a trivially copyable, standard-layout aggregate with at least 4 consecutive padding bytes");
+};
+#endif
+
 #if OPTION_CLANG
     #pragma clang diagnostic push
     #pragma clang diagnostic ignored "-Wcomma"
@@ -1785,6 +2454,29 @@ struct option_traits<T, decltype(sizeof(sentinel_option_traits<T>), void())> {
     }
 };
 
+template<class T>
+struct option_traits<T, decltype(sizeof(enumeration_option_traits<T>), void())> {
+private:
+    static_assert(std::is_enum_v<T>, "opt::enumeration_option_traits can only be specialized for enumeration types");
+
+    using underlying = std::make_unsigned_t<std::underlying_type_t<T>>;
+
+    static constexpr underlying max_value = underlying(enumeration_option_traits<T>::max_value);
+public:
+    // Every value greater than `max_value`
+    static constexpr std::uintmax_t max_level = std::uintmax_t(underlying(-1)) - std::uintmax_t(max_value);
+    static constexpr underlying empty_representation = underlying(max_value + 1u);
+
+    static constexpr std::uintmax_t get_level(const T* const value) noexcept {
+        // Values in [0, max_value] are wrapped around to [max_level, 2^N - 1]
+        return underlying(underlying(*value) - max_value - 1u);
+    }
+    static constexpr void set_level(T* const value, const std::uintmax_t level) noexcept {
+        OPTION_VERIFY(level < max_level, "Level is out of range");
+        *value = T(underlying(level + max_value + 1u));
+    }
+};
+
 #if OPTION_CLANG
     #pragma clang diagnostic pop
 #endif
@@ -1943,6 +2635,7 @@ namespace impl {
             impl::construct_at(OPTION_ADDRESSOF(value), static_cast<Args&&>(args)...);
             has_value_flag = true;
         }
+        constexpr void after_assign() noexcept {}
     };
     template<class T>
     struct option_destruct_base<T, /*TriviallyDestructible=*/false, /*HasTraits=*/false> {
@@ -1991,6 +2684,7 @@ namespace impl {
             impl::construct_at(OPTION_ADDRESSOF(value), static_cast<Args&&>(args)...);
             has_value_flag = true;
         }
+        constexpr void after_assign() noexcept {}
     };
 #if OPTION_GCC
     #pragma GCC diagnostic push
@@ -2015,22 +2709,26 @@ namespace impl {
         template<class... Args>
         constexpr option_destruct_base(const std::in_place_t, std::true_type, Args&&... args)
             : value{static_cast<Args&&>(args)...} {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
         template<class... Args>
         constexpr option_destruct_base(std::in_place_t, std::false_type, Args&&... args)
             : value(static_cast<Args&&>(args)...) {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
 
         template<class F, class Arg>
         constexpr option_destruct_base(construct_from_invoke_tag, std::true_type, F&& f, Arg&& arg)
             : value{impl::invoke(static_cast<F&&>(f), static_cast<Arg&&>(arg))} {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
         template<class F, class Arg>
         constexpr option_destruct_base(construct_from_invoke_tag, std::false_type, F&& f, Arg&& arg)
             : value(impl::invoke(static_cast<F&&>(f), static_cast<Arg&&>(arg))) {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
 
@@ -2044,8 +2742,13 @@ namespace impl {
         template<class... Args>
         constexpr void construct(Args&&... args) {
             impl::construct_at(OPTION_ADDRESSOF(value), static_cast<Args&&>(args)...);
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
+        // Called after assigning to the contained value
+        constexpr void after_assign() noexcept {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
+        }
     };
     template<class T>
     struct option_destruct_base<T, /*TriviallyDestructible=*/false, /*HasTraits=*/true> {
@@ -2066,21 +2769,25 @@ namespace impl {
         template<class... Args>
         constexpr option_destruct_base(const std::in_place_t, std::true_type, Args&&... args)
             : value{static_cast<Args&&>(args)...} {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
         template<class... Args>
         constexpr option_destruct_base(std::in_place_t, std::false_type, Args&&... args)
             : value(static_cast<Args&&>(args)...) {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
         template<class F, class Arg>
         constexpr option_destruct_base(construct_from_invoke_tag, std::true_type, F&& f, Arg&& arg)
             : value{impl::invoke(static_cast<F&&>(f), static_cast<Arg&&>(arg))} {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
         template<class F, class Arg>
         constexpr option_destruct_base(construct_from_invoke_tag, std::false_type, F&& f, Arg&& arg)
             : value(impl::invoke(static_cast<F&&>(f), static_cast<Arg&&>(arg))) {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
         OPTION_CONSTEXPR_CXX20 ~option_destruct_base() {
@@ -2102,8 +2809,13 @@ namespace impl {
         template<class... Args>
         constexpr void construct(Args&&... args) {
             impl::construct_at(OPTION_ADDRESSOF(value), static_cast<Args&&>(args)...);
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
             OPTION_VERIFY(has_value(), "After the construction, the value is in an empty state. Possibly because of the constructor arguments");
         }
+        // Called after assigning to the contained value
+        constexpr void after_assign() noexcept {
+            impl::traits_after_construct<traits>(OPTION_ADDRESSOF(value));
+        }
     };
 #if OPTION_GCC
     #pragma GCC diagnostic pop
@@ -2114,6 +2826,7 @@ namespace impl {
         if (other.has_value()) {
             if (self.has_value()) {
                 self.value = static_cast<Option&&>(other).value;
+                self.after_assign();
             } else {
                 self.construct(static_cast<Option&&>(other).value);
             }
@@ -2921,6 +3634,7 @@ public:
         } else {
             if (has_value()) {
                 base::value = static_cast<U&&>(val);
+                base::after_assign();
                 OPTION_VERIFY(has_value(), "After assignment, the value is in an empty state");
             } else {
                 base::construct(static_cast<U&&>(val));
@@ -2942,6 +3656,7 @@ public:
             if (other.has_value()) {
                 if (has_value()) {
                     base::value = other.get();
+                    base::after_assign();
                     OPTION_VERIFY(has_value(), "After assignment, the value is in an empty state");
                 } else {
                     base::construct(other.get());
@@ -2965,6 +3680,7 @@ public:
             if (other.has_value()) {
                 if (has_value()) {
                     base::value = static_cast<option<U>&&>(other).get();
+                    base::after_assign();
                     OPTION_VERIFY(has_value(), "After assignment, the value is in an empty state");
                 } else {
                     base::construct(static_cast<option<U>&&>(other).get());
@@ -3308,6 +4024,7 @@ namespace impl {
         using base = typename opt::option<T>::base;
 
         static constexpr std::uintmax_t max_level = 256;
+        static constexpr std::uintptr_t empty_representation = 1;
 
         static std::uintmax_t get_level(const opt::option<T>* const value) noexcept {
             const auto uint = reinterpret_cast<std::uintptr_t>(static_cast<const base*>(value)->value);
@@ -3398,6 +4115,77 @@ template<class T>
     return result;
 }
 
+namespace impl {
+#if !OPTION_UNKNOWN_STD
+    // `opt::option<T>` without `opt::option_traits` is stored in the same way as `std::optional<T>` (the value, then `bool` flag)
+    template<class T>
+    inline constexpr bool option_same_as_std_optional =
+        std::is_trivially_copyable_v<opt::option<T>> && std::is_trivially_copyable_v<std::optional<T>>
+        && opt::option_traits<T>::max_level == 0 && sizeof(opt::option<T>) == sizeof(std::optional<T>);
+
+    template<class T>
+    inline constexpr bool std_optional_copy_value = std::is_trivially_copyable_v<std::optional<T>>
+        && std::is_trivially_copyable_v<T> && !std::is_const_v<T>;
+#else
+    template<class T>
+    inline constexpr bool option_same_as_std_optional = false;
+
+    template<class T>
+    inline constexpr bool std_optional_copy_value = false;
+#endif
+}
+
+// Converts `std::optional<T>` into `opt::option<T>`
+template<class T>
+[[nodiscard]] OPTION_PURE opt::option<T> from_std_optional(const std::optional<T>& value) {
+    if constexpr (impl::option_same_as_std_optional<T>) {
+        opt::option<T> result;
+        std::memcpy(static_cast<void*>(OPTION_ADDRESSOF(result)), OPTION_ADDRESSOF(value), sizeof(result));
+        return result;
+    } else {
+        return value.has_value() ? opt::option<T>{std::in_place, *value} : opt::option<T>{opt::none};
+    }
+}
+template<class T>
+[[nodiscard]] OPTION_PURE opt::option<T> from_std_optional(std::optional<T>&& value) {
+    if constexpr (impl::option_same_as_std_optional<T>) {
+        return opt::from_std_optional(static_cast<const std::optional<T>&>(value));
+    } else {
+        return value.has_value() ? opt::option<T>{std::in_place, static_cast<T&&>(*value)} : opt::option<T>{opt::none};
+    }
+}
+
+// Converts `opt::option<T>` into `std::optional<T>`
+template<class T>
+[[nodiscard]] OPTION_PURE std::optional<T> to_std_optional(const opt::option<T>& value) {
+    if constexpr (impl::option_same_as_std_optional<T>) {
+        std::optional<T> result;
+        std::memcpy(static_cast<void*>(OPTION_ADDRESSOF(result)), OPTION_ADDRESSOF(value), sizeof(result));
+        return result;
+    } else
+#if !OPTION_UNKNOWN_STD
+    if constexpr (impl::std_optional_copy_value<T>) {
+        // Copy the value representation (even if the option is empty) and then set the "engaged" flag, without branching
+        std::optional<T> result;
+        std::memcpy(static_cast<void*>(OPTION_ADDRESSOF(result)), OPTION_ADDRESSOF(value.get_unchecked()), sizeof(T));
+        const bool engaged = value.has_value();
+        std::memcpy(reinterpret_cast<unsigned char*>(OPTION_ADDRESSOF(result)) + impl::std_optional_layout<T>::engaged_offset, &engaged, sizeof(bool));
+        return result;
+    } else
+#endif
+    {
+        return value.has_value() ? std::optional<T>{std::in_place, value.get_unchecked()} : std::optional<T>{};
+    }
+}
+template<class T>
+[[nodiscard]] OPTION_PURE std::optional<T> to_std_optional(opt::option<T>&& value) {
+    if constexpr (impl::option_same_as_std_optional<T> || impl::std_optional_copy_value<T>) {
+        return opt::to_std_optional(static_cast<const opt::option<T>&>(value));
+    } else {
+        return value.has_value() ? std::optional<T>{std::in_place, static_cast<opt::option<T>&&>(value).get_unchecked()} : std::optional<T>{};
+    }
+}
+
 template<class T, class U>
 constexpr impl::option::enable_swap<T, U> swap(option<T>& left, option<U>& right) noexcept(impl::option::nothrow_swap<T, U>) {
     left.swap(right);
@@ -3951,20 +4739,145 @@ namespace impl {
             OPTION_VERIFY(false, "Level is out of range");
         }
     }
+
+    template<class T, bool = std::is_enum_v<T>>
+    struct sentinel_integer { using type = T; };
+    template<class T>
+    struct sentinel_integer<T, true> { using type = std::underlying_type_t<T>; };
+
+    template<class T>
+    inline constexpr bool is_sentinel_integer = (std::is_integral_v<T> || std::is_enum_v<T>)
+        && !std::is_same_v<typename sentinel_integer<T>::type, bool>;
+
+    // `true` if the sentinel value `Value` is exactly representable in `T`,
+    // so comparing with it is the same as comparing the integer representations
+    template<class T, auto Value>
+    constexpr bool sentinel_value_fits() noexcept {
+        using value_t = std::remove_cv_t<decltype(Value)>;
+        if constexpr (std::is_same_v<value_t, T>) {
+            return true;
+        } else if constexpr (std::is_integral_v<T> && std::is_integral_v<value_t> && !std::is_same_v<value_t, bool>) {
+            if constexpr (std::is_signed_v<value_t>) {
+                if (Value < 0) {
+                    return std::is_signed_v<T> && std::intmax_t(Value) >= std::intmax_t(std::numeric_limits<T>::min());
+                }
+            }
+            return std::uintmax_t(Value) <= std::uintmax_t(std::numeric_limits<T>::max());
+        } else {
+            return false;
+        }
+    }
+
+    inline constexpr std::size_t sentinel_max_table_size = 256;
+
+    template<class Key, std::size_t N>
+    constexpr bool sentinel_keys_consecutive(const Key (&keys)[N]) noexcept {
+        for (std::size_t i = 0; i < N; ++i) {
+            if (keys[i] != Key(keys[0] + i)) { return false; }
+        }
+        return true;
+    }
+    template<class Key, std::size_t N>
+    constexpr Key sentinel_keys_min(const Key (&keys)[N]) noexcept {
+        Key result = keys[0];
+        for (const Key key : keys) { result = key < result ? key : result; }
+        return result;
+    }
+    template<class Key, std::size_t N>
+    constexpr Key sentinel_keys_max(const Key (&keys)[N]) noexcept {
+        Key result = keys[0];
+        for (const Key key : keys) { result = key > result ? key : result; }
+        return result;
+    }
+
+    // Levels indexed by the offset from the smallest sentinel value. `N` is an unused entry
+    struct sentinel_lookup_table {
+        std::uint8_t levels[sentinel_max_table_size];
+    };
+    template<class Key, std::size_t N>
+    constexpr sentinel_lookup_table make_sentinel_lookup_table(const Key (&keys)[N], const Key first) noexcept {
+        sentinel_lookup_table result{};
+        for (std::uint8_t& level : result.levels) {
+            level = std::uint8_t(N);
+        }
+        // The first of the duplicate values is used
+        for (std::size_t i = N; i-- > 0;) {
+            const std::size_t offset = Key(keys[i] - first);
+            if (offset < sentinel_max_table_size) {
+                result.levels[offset] = std::uint8_t(i);
+            }
+        }
+        return result;
+    }
+
+    // Constant time lookup of the level of integer or enumeration sentinel values.
+    // Uses a range check if the values are consecutive, or a table indexed by the offset from the smallest value
+    // if the values are close to each other
+    template<bool Enabled, class T, auto... Values>
+    struct sentinel_lookup {
+        static constexpr bool enabled = false;
+    };
+    template<class T, auto... Values>
+    struct sentinel_lookup<true, T, Values...> {
+    private:
+        using int_t = typename sentinel_integer<T>::type;
+        using key_t = std::make_unsigned_t<int_t>;
+
+        static constexpr std::size_t count = sizeof...(Values);
+        static constexpr key_t keys[]{key_t(T(Values))...};
+        static constexpr int_t ints[]{int_t(T(Values))...};
+
+        // The smallest value and the range are computed in the order of the underlying type
+        static constexpr key_t first = key_t(sentinel_keys_min(ints));
+        static constexpr std::uintmax_t span = std::uintmax_t(key_t(key_t(sentinel_keys_max(ints)) - first)) + 1;
+    public:
+        static constexpr bool consecutive = sentinel_keys_consecutive(keys);
+        static constexpr bool enabled = consecutive || (span <= sentinel_max_table_size && count < sentinel_max_table_size);
+
+        static constexpr std::uintmax_t get_level(const T& value) noexcept {
+            if constexpr (consecutive) {
+                const key_t offset = key_t(key_t(value) - keys[0]);
+                return offset < count ? offset : std::uintmax_t(-1);
+            } else {
+                const key_t offset = key_t(key_t(value) - first);
+                if (offset >= span) { return std::uintmax_t(-1); }
+                const std::uint8_t level = table.levels[offset];
+                return level != count ? level : std::uintmax_t(-1);
+            }
+        }
+        static constexpr void set_level(T& value, const std::uintmax_t level) noexcept {
+            OPTION_VERIFY(level < count, "Level is out of range");
+            value = T(keys[level]);
+        }
+    private:
+        static constexpr sentinel_lookup_table table = make_sentinel_lookup_table(keys, first);
+    };
 }
 
 template<class T, auto... Values>
 struct option_traits<sentinel<T, Values...>> {
 private:
     using value_t = sentinel<T, Values...>;
+
+    using lookup = impl::sentinel_lookup<
+        (impl::is_sentinel_integer<T> && sizeof...(Values) > 1 && (impl::sentinel_value_fits<T, Values>() && ...)),
+        T, Values...>;
 public:
     static constexpr std::uintmax_t max_level = sizeof...(Values);
 
     static constexpr std::uintmax_t get_level(const value_t* const value) noexcept {
-        return impl::sentinel_get_level_impl<T, 0, Values...>(*value);
+        if constexpr (lookup::enabled) {
+            return lookup::get_level(*value);
+        } else {
+            return impl::sentinel_get_level_impl<T, 0, Values...>(*value);
+        }
     }
     static constexpr void set_level(value_t* const value, const std::uintmax_t level) noexcept {
-        impl::sentinel_set_level_impl<T, 0, Values...>(*value, level);
+        if constexpr (lookup::enabled) {
+            lookup::set_level(*value, level);
+        } else {
+            impl::sentinel_set_level_impl<T, 0, Values...>(*value, level);
+        }
     }
 };
 
@@ -3977,7 +4890,7 @@ namespace impl {
         if (Compare{}(value, Value)) { return I; }
 
         if constexpr (sizeof...(Values) > 0) {
-            return sentinel_get_level_impl<T, Compare, I + 1, Values...>(value);
+            return sentinel_f_get_level_impl<T, Compare, I + 1, Values...>(value);
         } else {
             return std::uintmax_t(-1);
         }
@@ -3987,7 +4900,7 @@ namespace impl {
         if (level == I) { Set{}(value, Value); return; }
 
         if constexpr (sizeof...(Values) > 0) {
-            sentinel_set_level_impl<T, Set, I + 1, Values...>(value, level);
+            sentinel_f_set_level_impl<T, Set, I + 1, Values...>(value, level);
         } else {
             OPTION_VERIFY(false, "Level is out of range");
         }
@@ -4049,6 +4962,34 @@ public:
     }
 };
 
+template<class Int, Int Min, Int Max>
+struct bounded : impl::type_wrapper<Int> { using impl::type_wrapper<Int>::type_wrapper; };
+
+template<class Int, Int Min, Int Max>
+struct option_traits<bounded<Int, Min, Max>> {
+private:
+    static_assert(std::is_integral_v<Int> && !std::is_same_v<std::remove_cv_t<Int>, bool>,
+        "The type of opt::bounded must be an integer type");
+    static_assert(Min <= Max, "The range of opt::bounded is empty (Min > Max)");
+
+    using value_t = bounded<Int, Min, Max>;
+    using uint_t = std::make_unsigned_t<Int>;
+
+    static constexpr uint_t range = uint_t(uint_t(Max) - uint_t(Min));
+public:
+    // Every value outside of [Min, Max]
+    static constexpr std::uintmax_t max_level = uint_t(uint_t(-1) - range);
+
+    static constexpr std::uintmax_t get_level(const value_t* const value) noexcept {
+        // Values in [Min, Max] are wrapped around to [max_level, 2^N - 1]
+        return uint_t(uint_t(static_cast<const Int&>(*value)) - uint_t(Max) - 1u);
+    }
+    static constexpr void set_level(value_t* const value, const std::uintmax_t level) noexcept {
+        OPTION_VERIFY(level < max_level, "Level is out of range");
+        static_cast<Int&>(*value) = Int(uint_t(uint_t(Max) + 1u + uint_t(level)));
+    }
+};
+
 namespace impl {
     template<class T, class>
     using enable_hash_helper1 = T;
@@ -15,6 +15,9 @@ struct option_traits;
 template<class T, class = void>
 struct sentinel_option_traits;
 
+template<class T, class = void>
+struct enumeration_option_traits;
+
 template<class>
 struct is_option { static constexpr bool value = false; };
 template<class T>
@@ -0,0 +1,264 @@
+#pragma once
+
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <opt/option.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+
+namespace opt {
+
+namespace impl {
+    // Storage of a field without `opt::option_traits`. The "has value" state is stored in the shared bitmask
+    template<class T, bool TriviallyDestructible = impl::is_trivially_destructible_v<T>>
+    union option_tuple_slot {
+        T value;
+        char dummy;
+
+        constexpr option_tuple_slot() noexcept : dummy{} {}
+    };
+    template<class T>
+    union option_tuple_slot<T, false> {
+        T value;
+        char dummy;
+
+        option_tuple_slot() noexcept : dummy{} {}
+        ~option_tuple_slot() {}
+    };
+
+    template<class T>
+    inline constexpr bool option_tuple_is_flag_free = opt::option_traits<T>::max_level > 0;
+
+    // Fields with `opt::option_traits` are stored as `opt::option<T>` (the "has value" state is encoded inside the value)
+    template<class T>
+    using option_tuple_field = std::conditional_t<option_tuple_is_flag_free<T>, opt::option<T>, option_tuple_slot<T>>;
+
+    template<std::size_t FlagCount>
+    struct option_tuple_bits {
+        unsigned char bytes[(FlagCount + 7) / 8]{};
+
+        [[nodiscard]] bool test(const std::size_t index) const noexcept {
+            return ((bytes[index / 8] >> (index % 8)) & 1) != 0;
+        }
+        void set(const std::size_t index) noexcept {
+            bytes[index / 8] = static_cast<unsigned char>(bytes[index / 8] | (1u << (index % 8)));
+        }
+        void unset(const std::size_t index) noexcept {
+            bytes[index / 8] = static_cast<unsigned char>(bytes[index / 8] & ~(1u << (index % 8)));
+        }
+    };
+    template<>
+    struct option_tuple_bits<0> {};
+
+    // Index of the field `I` in the shared bitmask (the number of fields before `I` without `opt::option_traits`)
+    template<std::size_t I, class... Ts>
+    constexpr std::size_t option_tuple_flag_index() {
+        constexpr bool flag_free[]{option_tuple_is_flag_free<Ts>...};
+        std::size_t result = 0;
+        for (std::size_t i = 0; i < I; ++i) {
+            result += flag_free[i] ? 0 : 1;
+        }
+        return result;
+    }
+}
+
+// Tuple of optional fields.
+// Fields, that have `opt::option_traits`, are stored as `opt::option<T>` (with the same size as `T`), and do not use any flags.
+// The "has value" states of other fields are packed in a single bitmask (1 bit per field)
+template<class... Ts>
+class option_tuple {
+    static_assert(((!std::is_reference_v<Ts> && !std::is_array_v<Ts> && !std::is_void_v<Ts>) && ...),
+        "opt::option_tuple fields must be object types");
+
+    static constexpr std::size_t flag_count = impl::option_tuple_flag_index<sizeof...(Ts), Ts...>();
+
+    using fields_type = std::tuple<impl::option_tuple_field<Ts>..., impl::option_tuple_bits<flag_count>>;
+
+    fields_type fields;
+
+    template<std::size_t I>
+    using field_type = std::tuple_element_t<I, std::tuple<Ts...>>;
+
+    template<std::size_t I>
+    static constexpr std::size_t flag_index = impl::option_tuple_flag_index<I, Ts...>();
+
+    impl::option_tuple_bits<flag_count>& bits() noexcept { return std::get<sizeof...(Ts)>(fields); }
+    const impl::option_tuple_bits<flag_count>& bits() const noexcept { return std::get<sizeof...(Ts)>(fields); }
+
+    template<class Fn, std::size_t... Is>
+    static void for_each_index(Fn&& fn, std::index_sequence<Is...>) {
+        (fn(std::integral_constant<std::size_t, Is>{}), ...);
+    }
+    template<class Fn>
+    static void for_each_index(Fn&& fn) {
+        for_each_index(static_cast<Fn&&>(fn), std::index_sequence_for<Ts...>{});
+    }
+
+    // `const T&` if `Other` is a const reference; otherwise, `T&&`
+    template<std::size_t I, class Other>
+    using forward_field = std::conditional_t<std::is_const_v<std::remove_reference_t<Other>>, const field_type<I>&, field_type<I>&&>;
+
+    template<std::size_t I, class Other>
+    void construct_field_from(Other&& other) {
+        if (other.template has_value<I>()) {
+            emplace<I>(static_cast<forward_field<I, Other>>(*other.template get<I>()));
+        }
+    }
+    template<std::size_t I, class Other>
+    void assign_field_from(Other&& other) {
+        if (other.template has_value<I>()) {
+            if (has_value<I>()) {
+                *get<I>() = static_cast<forward_field<I, Other>>(*other.template get<I>());
+            } else {
+                emplace<I>(static_cast<forward_field<I, Other>>(*other.template get<I>()));
+            }
+        } else {
+            reset<I>();
+        }
+    }
+public:
+    static constexpr std::size_t size = sizeof...(Ts);
+
+    // `true` if the field `I` has `opt::option_traits` and does not use a bit in the shared bitmask
+    template<std::size_t I>
+    static constexpr bool is_flag_free = impl::option_tuple_is_flag_free<field_type<I>>;
+
+    // All fields are empty
+    option_tuple() = default;
+
+    // Constructs each field from the corresponding option
+    template<class... Us, std::enable_if_t<sizeof...(Us) == sizeof...(Ts) && sizeof...(Ts) != 0, int> = 0>
+    explicit option_tuple(opt::option<Us>... values) {
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            auto& value = std::get<I>(std::forward_as_tuple(values...));
+            if (value.has_value()) {
+                emplace<I>(*static_cast<std::remove_reference_t<decltype(value)>&&>(value));
+            }
+        });
+    }
+
+    option_tuple(const option_tuple& other) {
+        for_each_index([&](auto i) { construct_field_from<decltype(i)::value>(other); });
+    }
+    option_tuple(option_tuple&& other) noexcept((std::is_nothrow_move_constructible_v<Ts> && ...)) {
+        for_each_index([&](auto i) { construct_field_from<decltype(i)::value>(static_cast<option_tuple&&>(other)); });
+    }
+    option_tuple& operator=(const option_tuple& other) {
+        if (this != OPTION_ADDRESSOF(other)) {
+            for_each_index([&](auto i) { assign_field_from<decltype(i)::value>(other); });
+        }
+        return *this;
+    }
+    option_tuple& operator=(option_tuple&& other) noexcept((std::is_nothrow_move_assignable_v<Ts> && ...) && (std::is_nothrow_move_constructible_v<Ts> && ...)) {
+        if (this != OPTION_ADDRESSOF(other)) {
+            for_each_index([&](auto i) { assign_field_from<decltype(i)::value>(static_cast<option_tuple&&>(other)); });
+        }
+        return *this;
+    }
+
+    ~option_tuple() {
+        reset();
+    }
+
+    template<std::size_t I>
+    [[nodiscard]] bool has_value() const noexcept {
+        if constexpr (is_flag_free<I>) {
+            return std::get<I>(fields).has_value();
+        } else {
+            return bits().test(flag_index<I>);
+        }
+    }
+
+    // Returns a reference option to the field `I`
+    template<std::size_t I>
+    [[nodiscard]] opt::option<field_type<I>&> get() noexcept OPTION_LIFETIMEBOUND {
+        if (!has_value<I>()) {
+            return opt::none;
+        }
+        if constexpr (is_flag_free<I>) {
+            return opt::option<field_type<I>&>{std::get<I>(fields).get_unchecked()};
+        } else {
+            return opt::option<field_type<I>&>{std::get<I>(fields).value};
+        }
+    }
+    template<std::size_t I>
+    [[nodiscard]] opt::option<const field_type<I>&> get() const noexcept OPTION_LIFETIMEBOUND {
+        if (!has_value<I>()) {
+            return opt::none;
+        }
+        if constexpr (is_flag_free<I>) {
+            return opt::option<const field_type<I>&>{std::get<I>(fields).get_unchecked()};
+        } else {
+            return opt::option<const field_type<I>&>{std::get<I>(fields).value};
+        }
+    }
+
+    // Destroys the value of the field `I` (if any) and constructs a new one from `args...`
+    template<std::size_t I, class... Args>
+    field_type<I>& emplace(Args&&... args) OPTION_LIFETIMEBOUND {
+        if constexpr (is_flag_free<I>) {
+            return std::get<I>(fields).emplace(static_cast<Args&&>(args)...);
+        } else {
+            reset<I>();
+            auto& slot = std::get<I>(fields);
+            impl::construct_at(OPTION_ADDRESSOF(slot.value), static_cast<Args&&>(args)...);
+            bits().set(flag_index<I>);
+            return slot.value;
+        }
+    }
+
+    template<std::size_t I>
+    void reset() noexcept {
+        if constexpr (is_flag_free<I>) {
+            std::get<I>(fields).reset();
+        } else {
+            if (!bits().test(flag_index<I>)) { return; }
+            if constexpr (!impl::is_trivially_destructible_v<field_type<I>>) {
+                std::get<I>(fields).value.~field_type<I>();
+            }
+            bits().unset(flag_index<I>);
+        }
+    }
+    // Resets all fields
+    void reset() noexcept {
+        for_each_index([&](auto i) { reset<decltype(i)::value>(); });
+    }
+
+    // Moves the value of the field `I` out, leaving the field empty
+    template<std::size_t I>
+    [[nodiscard]] opt::option<field_type<I>> take() {
+        opt::option<field_type<I>> result;
+        if (has_value<I>()) {
+            result.emplace(static_cast<field_type<I>&&>(*get<I>()));
+            reset<I>();
+        }
+        return result;
+    }
+
+    // Number of fields, that contain a value
+    [[nodiscard]] std::size_t count() const noexcept {
+        std::size_t result = 0;
+        for_each_index([&](auto i) { result += std::size_t(has_value<decltype(i)::value>()); });
+        return result;
+    }
+
+    [[nodiscard]] friend bool operator==(const option_tuple& left, const option_tuple& right) {
+        bool result = true;
+        for_each_index([&](auto i) {
+            constexpr std::size_t I = decltype(i)::value;
+            result = result && left.template get<I>() == right.template get<I>();
+        });
+        return result;
+    }
+    [[nodiscard]] friend bool operator!=(const option_tuple& left, const option_tuple& right) {
+        return !(left == right);
+    }
+};
+
+}
@@ -0,0 +1,457 @@
+#pragma once
+
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <opt/option.hpp>
+#include <opt/algorithm.hpp>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <initializer_list>
+
+namespace opt {
+
+namespace impl {
+    inline constexpr std::size_t option_vector_word_bits = 64;
+
+    constexpr std::size_t option_vector_word_count(const std::size_t bits) noexcept {
+        return (bits + (option_vector_word_bits - 1)) / option_vector_word_bits;
+    }
+
+    template<class T, bool HasTraits = (opt::option_traits<T>::max_level > 0)>
+    class option_vector_storage;
+
+    // The "has value" state is already encoded inside the value (`opt::option<T>` has the same size as `T`),
+    // so the elements are stored inline
+    template<class T>
+    class option_vector_storage<T, /*HasTraits=*/true> {
+        std::vector<opt::option<T>> elements;
+    public:
+        option_vector_storage() = default;
+
+        [[nodiscard]] std::size_t size() const noexcept { return elements.size(); }
+        [[nodiscard]] std::size_t capacity() const noexcept { return elements.capacity(); }
+        void reserve(const std::size_t new_capacity) { elements.reserve(new_capacity); }
+        void shrink_to_fit() { elements.shrink_to_fit(); }
+
+        [[nodiscard]] bool has_value(const std::size_t index) const noexcept {
+            return elements[index].has_value();
+        }
+        [[nodiscard]] T* value_ptr(const std::size_t index) noexcept {
+            return OPTION_ADDRESSOF(elements[index].get_unchecked());
+        }
+        [[nodiscard]] const T* value_ptr(const std::size_t index) const noexcept {
+            return OPTION_ADDRESSOF(elements[index].get_unchecked());
+        }
+
+        template<class... Args>
+        T& construct(const std::size_t index, Args&&... args) {
+            return elements[index].emplace(static_cast<Args&&>(args)...);
+        }
+        void destroy(const std::size_t index) noexcept {
+            elements[index].reset();
+        }
+
+        void push_empty() { elements.emplace_back(); }
+        // `std::vector::emplace_back` constructs the new element before relocating the old ones,
+        // so the arguments may refer to the elements of this vector
+        template<class... Args>
+        T& push_value(Args&&... args) {
+            return elements.emplace_back(std::in_place, static_cast<Args&&>(args)...).get_unchecked();
+        }
+        void pop_back() noexcept { elements.pop_back(); }
+        void clear() noexcept { elements.clear(); }
+        void resize(const std::size_t new_size) { elements.resize(new_size); }
+
+        [[nodiscard]] std::size_t count() const noexcept {
+            return opt::count_engaged(elements.data(), elements.size());
+        }
+
+        void swap(option_vector_storage& other) noexcept {
+            elements.swap(other.elements);
+        }
+    };
+
+    // Stores values densely and keeps the "has value" state in a separate bitmap (1 bit per element)
+    template<class T>
+    class option_vector_storage<T, /*HasTraits=*/false> {
+        using value_allocator = std::allocator<T>;
+        using word_allocator = std::allocator<std::uint64_t>;
+
+        T* values = nullptr;
+        std::uint64_t* bits = nullptr;
+        std::size_t size_ = 0;
+        std::size_t capacity_ = 0;
+
+        // Invariant: bits of the elements at and after `size_` are always zero
+
+        // Invariant: a bit is set in `bits` if and only if the corresponding value is constructed
+        struct buffer {
+            T* values = nullptr;
+            std::uint64_t* bits = nullptr;
+            std::size_t capacity = 0;
+
+            explicit buffer(const std::size_t capacity_)
+                : capacity{capacity_} {
+                if (capacity == 0) { return; }
+                const std::size_t words = option_vector_word_count(capacity);
+                bits = word_allocator{}.allocate(words);
+                std::memset(bits, 0, words * sizeof(std::uint64_t));
+#if defined(__cpp_exceptions) && __cpp_exceptions >= 199711L
+                try {
+                    values = value_allocator{}.allocate(capacity);
+                } catch (...) {
+                    word_allocator{}.deallocate(bits, words);
+                    throw;
+                }
+#else
+                values = value_allocator{}.allocate(capacity);
+#endif
+            }
+            buffer(const buffer&) = delete;
+            buffer& operator=(const buffer&) = delete;
+
+            // Deallocates the storage that was not taken by `option_vector_storage` (only if an exception was thrown)
+            ~buffer() {
+                if (values == nullptr) { return; }
+                for (std::size_t i = 0; i < capacity; ++i) {
+                    if (test(bits, i)) {
+                        values[i].~T();
+                    }
+                }
+                deallocate(values, bits, capacity);
+            }
+        };
+
+        static bool test(const std::uint64_t* const words, const std::size_t index) noexcept {
+            return ((words[index / option_vector_word_bits] >> (index % option_vector_word_bits)) & 1) != 0;
+        }
+        static void set(std::uint64_t* const words, const std::size_t index) noexcept {
+            words[index / option_vector_word_bits] |= std::uint64_t(1) << (index % option_vector_word_bits);
+        }
+        static void unset(std::uint64_t* const words, const std::size_t index) noexcept {
+            words[index / option_vector_word_bits] &= ~(std::uint64_t(1) << (index % option_vector_word_bits));
+        }
+        static void deallocate(T* const values_, std::uint64_t* const bits_, const std::size_t capacity) noexcept {
+            if (values_ == nullptr) { return; }
+            value_allocator{}.deallocate(values_, capacity);
+            word_allocator{}.deallocate(bits_, option_vector_word_count(capacity));
+        }
+
+        void take(buffer& buf) noexcept {
+            destroy_all();
+            deallocate(values, bits, capacity_);
+            values = buf.values;
+            bits = buf.bits;
+            capacity_ = buf.capacity;
+            buf.values = nullptr;
+            buf.bits = nullptr;
+        }
+
+        void destroy_all() noexcept {
+            if constexpr (!impl::is_trivially_destructible_v<T>) {
+                for (std::size_t i = 0; i < size_; ++i) {
+                    if (test(bits, i)) {
+                        values[i].~T();
+                    }
+                }
+            }
+        }
+
+        // Moves the elements into `buf`, which may already contain constructed values after `size_`
+        void relocate_to(buffer& buf) {
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (size_ != 0) {
+                    std::memcpy(static_cast<void*>(buf.values), values, size_ * sizeof(T));
+                }
+            } else {
+                for (std::size_t i = 0; i < size_; ++i) {
+                    if (test(bits, i)) {
+                        impl::construct_at(buf.values + i, std::move_if_noexcept(values[i]));
+                        set(buf.bits, i);
+                    }
+                }
+            }
+            const std::size_t words = option_vector_word_count(size_);
+            for (std::size_t i = 0; i < words; ++i) {
+                buf.bits[i] |= bits[i];
+            }
+        }
+
+        void reallocate(const std::size_t new_capacity) {
+            buffer buf{new_capacity};
+            relocate_to(buf);
+            take(buf);
+        }
+
+        [[nodiscard]] std::size_t grown_capacity(const std::size_t new_size) const noexcept {
+            std::size_t new_capacity = capacity_ * 2;
+            if (new_capacity < new_size) { new_capacity = new_size; }
+            if (new_capacity < option_vector_word_bits) { new_capacity = option_vector_word_bits; }
+            return new_capacity;
+        }
+
+        void grow_for(const std::size_t new_size) {
+            if (new_size <= capacity_) { return; }
+            reallocate(grown_capacity(new_size));
+        }
+    public:
+        option_vector_storage() = default;
+
+        option_vector_storage(const option_vector_storage& other)
+            : option_vector_storage() {
+            grow_for(other.size_);
+            if constexpr (std::is_trivially_copyable_v<T>) {
+                if (other.size_ != 0) {
+                    std::memcpy(static_cast<void*>(values), other.values, other.size_ * sizeof(T));
+                    std::memcpy(bits, other.bits, option_vector_word_count(other.size_) * sizeof(std::uint64_t));
+                }
+                size_ = other.size_;
+            } else {
+                for (std::size_t i = 0; i < other.size_; ++i) {
+                    if (test(other.bits, i)) {
+                        push_value(other.values[i]);
+                    } else {
+                        push_empty();
+                    }
+                }
+            }
+        }
+        option_vector_storage(option_vector_storage&& other) noexcept
+            : values{other.values}, bits{other.bits}, size_{other.size_}, capacity_{other.capacity_} {
+            other.values = nullptr;
+            other.bits = nullptr;
+            other.size_ = 0;
+            other.capacity_ = 0;
+        }
+        option_vector_storage& operator=(const option_vector_storage& other) {
+            if (this != &other) {
+                option_vector_storage tmp{other};
+                swap(tmp);
+            }
+            return *this;
+        }
+        option_vector_storage& operator=(option_vector_storage&& other) noexcept {
+            option_vector_storage tmp{static_cast<option_vector_storage&&>(other)};
+            swap(tmp);
+            return *this;
+        }
+        ~option_vector_storage() {
+            destroy_all();
+            deallocate(values, bits, capacity_);
+        }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+        void reserve(const std::size_t new_capacity) {
+            if (new_capacity > capacity_) {
+                reallocate(new_capacity);
+            }
+        }
+        void shrink_to_fit() {
+            if (size_ == 0) {
+                buffer empty{0};
+                take(empty);
+            } else if (size_ < capacity_) {
+                reallocate(size_);
+            }
+        }
+
+        [[nodiscard]] bool has_value(const std::size_t index) const noexcept {
+            return test(bits, index);
+        }
+        [[nodiscard]] T* value_ptr(const std::size_t index) noexcept {
+            return values + index;
+        }
+        [[nodiscard]] const T* value_ptr(const std::size_t index) const noexcept {
+            return values + index;
+        }
+
+        template<class... Args>
+        T& construct(const std::size_t index, Args&&... args) {
+            OPTION_VERIFY(!test(bits, index), "The element must be empty before the construction");
+            impl::construct_at(values + index, static_cast<Args&&>(args)...);
+            set(bits, index);
+            return values[index];
+        }
+        void destroy(const std::size_t index) noexcept {
+            if (test(bits, index)) {
+                values[index].~T();
+                unset(bits, index);
+            }
+        }
+
+        void push_empty() {
+            grow_for(size_ + 1);
+            size_ += 1;
+        }
+        template<class... Args>
+        T& push_value(Args&&... args) {
+            if (size_ == capacity_) {
+                // The arguments may refer to the current elements,
+                // so the new element is constructed before they are moved from
+                buffer buf{grown_capacity(size_ + 1)};
+                impl::construct_at(buf.values + size_, static_cast<Args&&>(args)...);
+                set(buf.bits, size_);
+                relocate_to(buf);
+                take(buf);
+            } else {
+                impl::construct_at(values + size_, static_cast<Args&&>(args)...);
+                set(bits, size_);
+            }
+            size_ += 1;
+            return values[size_ - 1];
+        }
+        void pop_back() noexcept {
+            OPTION_VERIFY(size_ != 0, "Calling pop_back on an empty opt::option_vector");
+            destroy(size_ - 1);
+            size_ -= 1;
+        }
+        void clear() noexcept {
+            destroy_all();
+            if (size_ != 0) {
+                std::memset(bits, 0, option_vector_word_count(size_) * sizeof(std::uint64_t));
+            }
+            size_ = 0;
+        }
+        void resize(const std::size_t new_size) {
+            while (size_ > new_size) {
+                pop_back();
+            }
+            grow_for(new_size);
+            size_ = new_size;
+        }
+
+        [[nodiscard]] std::size_t count() const noexcept {
+            std::size_t result = 0;
+            const std::size_t words = option_vector_word_count(size_);
+            for (std::size_t i = 0; i < words; ++i) {
+                result += impl::popcount64(bits[i]);
+            }
+            return result;
+        }
+
+        void swap(option_vector_storage& other) noexcept {
+            std::swap(values, other.values);
+            std::swap(bits, other.bits);
+            std::swap(size_, other.size_);
+            std::swap(capacity_, other.capacity_);
+        }
+    };
+}
+
+template<class T>
+class option_vector {
+    static_assert(!std::is_reference_v<T>, "opt::option_vector<T> does not support reference types");
+    static_assert(!std::is_const_v<T>, "opt::option_vector<T> does not support const types");
+
+    impl::option_vector_storage<T> storage;
+public:
+    using value_type = opt::option<T>;
+    using size_type = std::size_t;
+    using reference = opt::option<T&>;
+    using const_reference = opt::option<const T&>;
+
+    // `true` when the "has value" states are stored in a separate bitmap, `false` when they are encoded inside the values
+    static constexpr bool is_bitmap_packed = !(opt::option_traits<T>::max_level > 0);
+
+    option_vector() = default;
+
+    explicit option_vector(const size_type count) {
+        resize(count);
+    }
+    option_vector(const std::initializer_list<opt::option<T>> ilist) {
+        reserve(ilist.size());
+        for (const opt::option<T>& x : ilist) {
+            push_back(x);
+        }
+    }
+
+    [[nodiscard]] size_type size() const noexcept { return storage.size(); }
+    [[nodiscard]] bool empty() const noexcept { return storage.size() == 0; }
+    [[nodiscard]] size_type capacity() const noexcept { return storage.capacity(); }
+
+    void reserve(const size_type new_capacity) { storage.reserve(new_capacity); }
+    void shrink_to_fit() { storage.shrink_to_fit(); }
+    void clear() noexcept { storage.clear(); }
+    // New elements are empty
+    void resize(const size_type new_size) { storage.resize(new_size); }
+
+    // Returns the number of elements that contain a value
+    [[nodiscard]] size_type count() const noexcept { return storage.count(); }
+
+    [[nodiscard]] bool has_value(const size_type index) const noexcept {
+        OPTION_VERIFY(index < size(), "Index is out of range");
+        return storage.has_value(index);
+    }
+
+    [[nodiscard]] reference operator[](const size_type index) noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(index < size(), "Index is out of range");
+        if (storage.has_value(index)) {
+            return reference{*storage.value_ptr(index)};
+        }
+        return opt::none;
+    }
+    [[nodiscard]] const_reference operator[](const size_type index) const noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(index < size(), "Index is out of range");
+        if (storage.has_value(index)) {
+            return const_reference{*storage.value_ptr(index)};
+        }
+        return opt::none;
+    }
+
+    void push_back(const T& value) { storage.push_value(value); }
+    void push_back(T&& value) { storage.push_value(static_cast<T&&>(value)); }
+    void push_back(opt::none_t) { storage.push_empty(); }
+    void push_back(const opt::option<T>& value) {
+        if (value.has_value()) {
+            storage.push_value(value.get());
+        } else {
+            storage.push_empty();
+        }
+    }
+    void push_back(opt::option<T>&& value) {
+        if (value.has_value()) {
+            storage.push_value(static_cast<opt::option<T>&&>(value).get());
+        } else {
+            storage.push_empty();
+        }
+    }
+
+    template<class... Args>
+    T& emplace_back(Args&&... args) OPTION_LIFETIMEBOUND {
+        return storage.push_value(static_cast<Args&&>(args)...);
+    }
+
+    // Destroys the contained value (if any) at `index` and constructs a new one in place
+    template<class... Args>
+    T& emplace(const size_type index, Args&&... args) OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(index < size(), "Index is out of range");
+        storage.destroy(index);
+        return storage.construct(index, static_cast<Args&&>(args)...);
+    }
+
+    void reset(const size_type index) noexcept {
+        OPTION_VERIFY(index < size(), "Index is out of range");
+        storage.destroy(index);
+    }
+
+    void pop_back() noexcept {
+        OPTION_VERIFY(!empty(), "Calling pop_back on an empty opt::option_vector");
+        storage.pop_back();
+    }
+
+    void swap(option_vector& other) noexcept {
+        storage.swap(other.storage);
+    }
+    friend void swap(option_vector& left, option_vector& right) noexcept {
+        left.swap(right);
+    }
+};
+
+}
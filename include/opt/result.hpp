@@ -0,0 +1,537 @@
+#pragma once
+
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <opt/option.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+namespace opt {
+
+struct in_place_error_t {
+    explicit in_place_error_t() = default;
+};
+inline constexpr in_place_error_t in_place_error{};
+
+template<class T, class E>
+class result;
+
+template<class T>
+inline constexpr bool is_result_v = false;
+template<class T, class E>
+inline constexpr bool is_result_v<opt::result<T, E>> = true;
+
+namespace impl {
+    // The number of distinct values of `E`, if `E` is small enough to be encoded in the levels of `opt::option_traits`.
+    // Otherwise, zero
+    template<class E>
+    constexpr std::uintmax_t result_error_states() {
+        if constexpr (std::is_empty_v<E> && std::is_trivially_copyable_v<E> && std::is_default_constructible_v<E>) {
+            return 1;
+        } else if constexpr (std::is_same_v<E, bool>) {
+            return 2;
+        } else if constexpr (std::is_enum_v<E>) {
+#if OPTION_USE_BUILTIN_TRAITS
+            constexpr option_strategy strategy = impl::detemine_option_strategy<E>();
+            if constexpr (strategy == option_strategy::enumeration_sentinel) {
+                // Enumerators are in the range [0, SENTINEL]
+                using underlying = std::underlying_type_t<E>;
+                if constexpr (std::is_signed_v<underlying>) {
+                    if (underlying(E::SENTINEL) < 0) { return 0; }
+                }
+                return std::uintmax_t(underlying(E::SENTINEL)) + 1;
+            } else
+#if OPTION_CAN_REFLECT_ENUM
+            if constexpr (strategy == option_strategy::enumeration) {
+                return internal_option_traits<E, option_strategy::enumeration>::max_enumerator_value;
+            } else
+#endif
+#endif
+            if constexpr (sizeof(E) <= 2) {
+                return std::uintmax_t(1) << (sizeof(E) * 8);
+            } else {
+                return 0;
+            }
+        } else if constexpr (std::is_integral_v<E> && sizeof(E) <= 2) {
+            return std::uintmax_t(1) << (sizeof(E) * 8);
+        } else {
+            return 0;
+        }
+    }
+
+    template<class E, bool = std::is_enum_v<E>>
+    struct result_error_unsigned_impl { using type = std::make_unsigned_t<E>; };
+    template<class E>
+    struct result_error_unsigned_impl<E, true> { using type = std::make_unsigned_t<std::underlying_type_t<E>>; };
+
+    template<class E>
+    using result_error_unsigned = typename result_error_unsigned_impl<E>::type;
+
+    template<class E>
+    constexpr std::uintmax_t result_error_to_level(const E& error) noexcept {
+        if constexpr (std::is_empty_v<E>) {
+            return 0;
+        } else if constexpr (std::is_same_v<E, bool>) {
+            return std::uintmax_t(error);
+        } else {
+            return std::uintmax_t(static_cast<result_error_unsigned<E>>(error));
+        }
+    }
+    template<class E>
+    constexpr E result_error_from_level(const std::uintmax_t level) noexcept {
+        if constexpr (std::is_empty_v<E>) {
+            return E{};
+        } else if constexpr (std::is_same_v<E, bool>) {
+            return level != 0;
+        } else {
+            return static_cast<E>(static_cast<result_error_unsigned<E>>(level));
+        }
+    }
+
+    template<bool TriviallyDestructible, class T, class E>
+    union result_union {
+        T value;
+        E error;
+        char dummy;
+
+        constexpr result_union() noexcept : dummy{} {}
+    };
+    template<class T, class E>
+    union result_union<false, T, E> {
+        T value;
+        E error;
+        char dummy;
+
+        result_union() noexcept : dummy{} {}
+        ~result_union() {}
+    };
+
+    template<class T, class E, class U>
+    inline constexpr bool result_is_value_convertible =
+        std::is_constructible_v<T, U&&>
+        && !std::is_same_v<remove_cvref<U>, opt::result<T, E>>
+        && !std::is_same_v<remove_cvref<U>, std::in_place_t>
+        && !std::is_same_v<remove_cvref<U>, opt::in_place_error_t>;
+}
+
+// Contains either a value of type `T` or an error of type `E`.
+// If `E` is small (an empty type, `bool`, an enumeration with the `SENTINEL` enumerator or with reflectable enumerators,
+// or an integral/enumeration type with the size of at most 2 bytes),
+// and `opt::option_traits<T>` has enough levels for all values of `E`,
+// the error is encoded in the unused states (levels) of `T`, and the size of `opt::result<T, E>` is equal to the size of `T`.
+// Otherwise, `T` and `E` are stored in a union with a separate flag
+template<class T, class E>
+class result {
+    static_assert(!std::is_reference_v<T> && !std::is_reference_v<E>, "opt::result does not support reference types");
+    static_assert(!std::is_void_v<T> && !std::is_void_v<E>, "opt::result does not support void");
+    static_assert(std::is_nothrow_move_constructible_v<T> && std::is_nothrow_move_constructible_v<E>,
+        "opt::result requires T and E to be nothrow move constructible");
+
+    template<class, class>
+    friend struct opt::option_traits;
+    template<class, class>
+    friend class result;
+
+    using value_traits = opt::option_traits<T>;
+
+    static constexpr std::uintmax_t error_states = impl::result_error_states<E>();
+public:
+    // `true` if the error is stored in the unused states of `T`, and the size of `opt::result<T, E>` is equal to the size of `T`
+    static constexpr bool is_niche_packed = error_states != 0 && value_traits::max_level >= error_states;
+private:
+    static constexpr bool trivially_destructible = std::is_trivially_destructible_v<T> && std::is_trivially_destructible_v<E>;
+
+    using union_type = impl::result_union<trivially_destructible, T, E>;
+
+    struct packed_storage {
+        union_type u;
+    };
+    struct separate_storage {
+        union_type u;
+        bool has_value;
+    };
+    std::conditional_t<is_niche_packed, packed_storage, separate_storage> storage;
+
+    template<class... Args>
+    void construct_value(Args&&... args) {
+        impl::construct_at(OPTION_ADDRESSOF(storage.u.value), static_cast<Args&&>(args)...);
+        if constexpr (is_niche_packed) {
+            OPTION_VERIFY(value_traits::get_level(OPTION_ADDRESSOF(storage.u.value)) >= error_states,
+                "After the construction, the value is in one of its unused states");
+        } else {
+            storage.has_value = true;
+        }
+    }
+    template<class... Args>
+    void construct_error(Args&&... args) {
+        if constexpr (is_niche_packed) {
+            value_traits::set_level(OPTION_ADDRESSOF(storage.u.value), impl::result_error_to_level(E(static_cast<Args&&>(args)...)));
+        } else {
+            impl::construct_at(OPTION_ADDRESSOF(storage.u.error), static_cast<Args&&>(args)...);
+            storage.has_value = false;
+        }
+    }
+    void destroy() noexcept {
+        if constexpr (!trivially_destructible) {
+            if (has_value()) {
+                storage.u.value.~T();
+            } else if constexpr (!is_niche_packed) {
+                storage.u.error.~E();
+            }
+        }
+    }
+
+    void copy_error_level(const result& other) noexcept {
+        value_traits::set_level(OPTION_ADDRESSOF(storage.u.value), value_traits::get_level(OPTION_ADDRESSOF(other.storage.u.value)));
+    }
+
+    template<class Other>
+    void construct_from(Other&& other) {
+        if (other.has_value()) {
+            construct_value(*static_cast<Other&&>(other));
+        } else if constexpr (is_niche_packed) {
+            copy_error_level(other);
+        } else {
+            construct_error(static_cast<Other&&>(other).error());
+        }
+    }
+    template<class Other>
+    void assign_from(Other&& other) {
+        if (has_value() && other.has_value()) {
+            storage.u.value = *static_cast<Other&&>(other);
+        } else if (other.has_value()) {
+            emplace(*static_cast<Other&&>(other));
+        } else if constexpr (is_niche_packed) {
+            destroy();
+            copy_error_level(other);
+        } else {
+            if (has_value()) {
+                // Construct a temporary first, so the result is not left without a value when the copy constructor throws
+                E temp(static_cast<Other&&>(other).error());
+                destroy();
+                construct_error(static_cast<E&&>(temp));
+            } else {
+                storage.u.error = static_cast<Other&&>(other).error();
+            }
+        }
+    }
+
+    template<class Self, class F>
+    static auto map_impl(Self&& self, F&& f) {
+        using f_result = std::remove_cv_t<decltype(impl::invoke(static_cast<F&&>(f), *static_cast<Self&&>(self)))>;
+        using res = opt::result<f_result, E>;
+        if (self.has_value()) {
+            return res{std::in_place, impl::invoke(static_cast<F&&>(f), *static_cast<Self&&>(self))};
+        }
+        return res{opt::in_place_error, static_cast<Self&&>(self).error()};
+    }
+    template<class Self, class F>
+    static auto map_error_impl(Self&& self, F&& f) {
+        using f_result = std::remove_cv_t<decltype(impl::invoke(static_cast<F&&>(f), static_cast<Self&&>(self).error()))>;
+        using res = opt::result<T, f_result>;
+        if (self.has_value()) {
+            return res{std::in_place, *static_cast<Self&&>(self)};
+        }
+        return res{opt::in_place_error, impl::invoke(static_cast<F&&>(f), static_cast<Self&&>(self).error())};
+    }
+    template<class Self, class F>
+    static auto and_then_impl(Self&& self, F&& f) {
+        using invoke_res = impl::remove_cvref<decltype(impl::invoke(static_cast<F&&>(f), *static_cast<Self&&>(self)))>;
+        static_assert(opt::is_result_v<invoke_res>, "The return type of function F must be a specialization of opt::result");
+        if (self.has_value()) {
+            return impl::invoke(static_cast<F&&>(f), *static_cast<Self&&>(self));
+        }
+        return invoke_res{opt::in_place_error, static_cast<Self&&>(self).error()};
+    }
+    template<class Self, class F>
+    static auto or_else_impl(Self&& self, F&& f) {
+        using invoke_res = impl::remove_cvref<decltype(impl::invoke(static_cast<F&&>(f), static_cast<Self&&>(self).error()))>;
+        static_assert(opt::is_result_v<invoke_res>, "The return type of function F must be a specialization of opt::result");
+        if (self.has_value()) {
+            return invoke_res{std::in_place, *static_cast<Self&&>(self)};
+        }
+        return impl::invoke(static_cast<F&&>(f), static_cast<Self&&>(self).error());
+    }
+public:
+    using value_type = T;
+    using error_type = E;
+
+    // Value-initializes the contained value
+    result() noexcept(std::is_nothrow_default_constructible_v<T>) {
+        construct_value();
+    }
+
+    template<class U = T, std::enable_if_t<impl::result_is_value_convertible<T, E, U>, int> = 0>
+    result(U&& value) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
+        construct_value(static_cast<U&&>(value));
+    }
+    template<class... Args>
+    explicit result(std::in_place_t, Args&&... args) noexcept(std::is_nothrow_constructible_v<T, Args&&...>) {
+        construct_value(static_cast<Args&&>(args)...);
+    }
+    template<class... Args>
+    explicit result(opt::in_place_error_t, Args&&... args) noexcept(std::is_nothrow_constructible_v<E, Args&&...>) {
+        construct_error(static_cast<Args&&>(args)...);
+    }
+
+    // Contains the value of `value` if it has one; otherwise, the error `error`
+    template<class U, class G>
+    result(const opt::option<U>& value, G&& error) {
+        if (value.has_value()) {
+            construct_value(*value);
+        } else {
+            construct_error(static_cast<G&&>(error));
+        }
+    }
+    template<class U, class G>
+    result(opt::option<U>&& value, G&& error) {
+        if (value.has_value()) {
+            construct_value(*static_cast<opt::option<U>&&>(value));
+        } else {
+            construct_error(static_cast<G&&>(error));
+        }
+    }
+
+    result(const result& other) {
+        construct_from(other);
+    }
+    result(result&& other) noexcept {
+        construct_from(static_cast<result&&>(other));
+    }
+    result& operator=(const result& other) {
+        assign_from(other);
+        return *this;
+    }
+    result& operator=(result&& other) noexcept(std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_assignable_v<E>) {
+        assign_from(static_cast<result&&>(other));
+        return *this;
+    }
+
+    ~result() {
+        destroy();
+    }
+
+    template<class... Args>
+    T& emplace(Args&&... args) OPTION_LIFETIMEBOUND {
+        if constexpr (std::is_nothrow_constructible_v<T, Args&&...>) {
+            destroy();
+            construct_value(static_cast<Args&&>(args)...);
+        } else {
+            T temp(static_cast<Args&&>(args)...);
+            destroy();
+            construct_value(static_cast<T&&>(temp));
+        }
+        return storage.u.value;
+    }
+    template<class... Args>
+    void emplace_error(Args&&... args) {
+        if constexpr (std::is_nothrow_constructible_v<E, Args&&...>) {
+            destroy();
+            construct_error(static_cast<Args&&>(args)...);
+        } else {
+            E temp(static_cast<Args&&>(args)...);
+            destroy();
+            construct_error(static_cast<E&&>(temp));
+        }
+    }
+
+    [[nodiscard]] OPTION_PURE bool has_value() const noexcept {
+        if constexpr (is_niche_packed) {
+            return value_traits::get_level(OPTION_ADDRESSOF(storage.u.value)) >= error_states;
+        } else {
+            return storage.has_value;
+        }
+    }
+    [[nodiscard]] explicit operator bool() const noexcept {
+        return has_value();
+    }
+
+    [[nodiscard]] OPTION_PURE T& operator*() & noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(has_value(), "Accessing the value of an opt::result that contains an error");
+        return storage.u.value;
+    }
+    [[nodiscard]] OPTION_PURE const T& operator*() const& noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(has_value(), "Accessing the value of an opt::result that contains an error");
+        return storage.u.value;
+    }
+    [[nodiscard]] OPTION_PURE T&& operator*() && noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(has_value(), "Accessing the value of an opt::result that contains an error");
+        return static_cast<T&&>(storage.u.value);
+    }
+    [[nodiscard]] OPTION_PURE T* operator->() noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(has_value(), "Accessing the value of an opt::result that contains an error");
+        return OPTION_ADDRESSOF(storage.u.value);
+    }
+    [[nodiscard]] OPTION_PURE const T* operator->() const noexcept OPTION_LIFETIMEBOUND {
+        OPTION_VERIFY(has_value(), "Accessing the value of an opt::result that contains an error");
+        return OPTION_ADDRESSOF(storage.u.value);
+    }
+
+    // Throws `opt::bad_access` if the result contains an error
+    [[nodiscard]] T& value() & OPTION_LIFETIMEBOUND {
+        if (!has_value()) { impl::throw_bad_access(); }
+        return storage.u.value;
+    }
+    [[nodiscard]] const T& value() const& OPTION_LIFETIMEBOUND {
+        if (!has_value()) { impl::throw_bad_access(); }
+        return storage.u.value;
+    }
+    [[nodiscard]] T&& value() && OPTION_LIFETIMEBOUND {
+        if (!has_value()) { impl::throw_bad_access(); }
+        return static_cast<T&&>(storage.u.value);
+    }
+
+    // Returns the contained error.
+    // If the error is stored in the unused states of `T`, it is returned by value; otherwise, by reference
+    [[nodiscard]] decltype(auto) error() const& noexcept {
+        OPTION_VERIFY(!has_value(), "Accessing the error of an opt::result that contains a value");
+        if constexpr (is_niche_packed) {
+            return impl::result_error_from_level<E>(value_traits::get_level(OPTION_ADDRESSOF(storage.u.value)));
+        } else {
+            return static_cast<const E&>(storage.u.error);
+        }
+    }
+    [[nodiscard]] decltype(auto) error() && noexcept {
+        OPTION_VERIFY(!has_value(), "Accessing the error of an opt::result that contains a value");
+        if constexpr (is_niche_packed) {
+            return impl::result_error_from_level<E>(value_traits::get_level(OPTION_ADDRESSOF(storage.u.value)));
+        } else {
+            return static_cast<E&&>(storage.u.error);
+        }
+    }
+
+    template<class U>
+    [[nodiscard]] T value_or(U&& default_value) const& {
+        if (has_value()) {
+            return storage.u.value;
+        }
+        return static_cast<T>(static_cast<U&&>(default_value));
+    }
+    template<class U>
+    [[nodiscard]] T value_or(U&& default_value) && {
+        if (has_value()) {
+            return static_cast<T&&>(storage.u.value);
+        }
+        return static_cast<T>(static_cast<U&&>(default_value));
+    }
+
+    // Converts to `opt::option<T>`, discarding the error
+    [[nodiscard]] opt::option<T> ok() const& {
+        if (has_value()) {
+            return opt::option<T>{storage.u.value};
+        }
+        return opt::none;
+    }
+    [[nodiscard]] opt::option<T> ok() && {
+        if (has_value()) {
+            return opt::option<T>{static_cast<T&&>(storage.u.value)};
+        }
+        return opt::none;
+    }
+    // Converts to `opt::option<E>`, discarding the value
+    [[nodiscard]] opt::option<E> err() const& {
+        if (has_value()) {
+            return opt::none;
+        }
+        return opt::option<E>{error()};
+    }
+    [[nodiscard]] opt::option<E> err() && {
+        if (has_value()) {
+            return opt::none;
+        }
+        return opt::option<E>{static_cast<result&&>(*this).error()};
+    }
+
+    // Returns `opt::result<U, E>` with the result of `f` invoked with the contained value, or the contained error
+    template<class F>
+    [[nodiscard]] auto map(F&& f) & { return map_impl(*this, static_cast<F&&>(f)); }
+    template<class F>
+    [[nodiscard]] auto map(F&& f) const& { return map_impl(*this, static_cast<F&&>(f)); }
+    template<class F>
+    [[nodiscard]] auto map(F&& f) && { return map_impl(static_cast<result&&>(*this), static_cast<F&&>(f)); }
+
+    // Returns `opt::result<T, G>` with the contained value, or the result of `f` invoked with the contained error
+    template<class F>
+    [[nodiscard]] auto map_error(F&& f) & { return map_error_impl(*this, static_cast<F&&>(f)); }
+    template<class F>
+    [[nodiscard]] auto map_error(F&& f) const& { return map_error_impl(*this, static_cast<F&&>(f)); }
+    template<class F>
+    [[nodiscard]] auto map_error(F&& f) && { return map_error_impl(static_cast<result&&>(*this), static_cast<F&&>(f)); }
+
+    // Returns the result of `f` (a specialization of `opt::result`) invoked with the contained value, or the contained error
+    template<class F>
+    [[nodiscard]] auto and_then(F&& f) & { return and_then_impl(*this, static_cast<F&&>(f)); }
+    template<class F>
+    [[nodiscard]] auto and_then(F&& f) const& { return and_then_impl(*this, static_cast<F&&>(f)); }
+    template<class F>
+    [[nodiscard]] auto and_then(F&& f) && { return and_then_impl(static_cast<result&&>(*this), static_cast<F&&>(f)); }
+
+    // Returns the contained value, or the result of `f` (a specialization of `opt::result`) invoked with the contained error
+    template<class F>
+    [[nodiscard]] auto or_else(F&& f) & { return or_else_impl(*this, static_cast<F&&>(f)); }
+    template<class F>
+    [[nodiscard]] auto or_else(F&& f) const& { return or_else_impl(*this, static_cast<F&&>(f)); }
+    template<class F>
+    [[nodiscard]] auto or_else(F&& f) && { return or_else_impl(static_cast<result&&>(*this), static_cast<F&&>(f)); }
+
+    void swap(result& other) noexcept(std::is_nothrow_move_assignable_v<T> && std::is_nothrow_move_assignable_v<E>) {
+        result temp{static_cast<result&&>(other)};
+        other = static_cast<result&&>(*this);
+        *this = static_cast<result&&>(temp);
+    }
+    friend void swap(result& left, result& right) noexcept(noexcept(left.swap(right))) {
+        left.swap(right);
+    }
+
+    [[nodiscard]] friend bool operator==(const result& left, const result& right) {
+        if (left.has_value() != right.has_value()) {
+            return false;
+        }
+        if (left.has_value()) {
+            return bool(*left == *right);
+        }
+        return bool(left.error() == right.error());
+    }
+    [[nodiscard]] friend bool operator!=(const result& left, const result& right) {
+        return !(left == right);
+    }
+};
+
+template<class T, class E>
+struct option_traits<result<T, E>> {
+private:
+    using res = result<T, E>;
+    using value_traits = typename res::value_traits;
+public:
+    // The levels of `T`, that are not used for the error.
+    // Or the values of the separate `bool` flag, other than `false` and `true`
+    static constexpr std::uintmax_t max_level = res::is_niche_packed
+        ? value_traits::max_level - res::error_states
+        : 254;
+
+    static std::uintmax_t get_level(const res* const value) noexcept {
+        if constexpr (res::is_niche_packed) {
+            return value_traits::get_level(OPTION_ADDRESSOF(value->storage.u.value)) - res::error_states;
+        } else {
+            std::uint8_t flag{};
+            std::memcpy(&flag, OPTION_ADDRESSOF(value->storage.has_value), sizeof(flag));
+            return std::uint8_t(flag - 2);
+        }
+    }
+    static void set_level(res* const value, const std::uintmax_t level) noexcept {
+        OPTION_VERIFY(level < max_level, "Level is out of range");
+        if constexpr (res::is_niche_packed) {
+            value_traits::set_level(OPTION_ADDRESSOF(value->storage.u.value), level + res::error_states);
+        } else {
+            const std::uint8_t flag = std::uint8_t(level + 2);
+            std::memcpy(OPTION_ADDRESSOF(value->storage.has_value), &flag, sizeof(flag));
+        }
+    }
+};
+
+}
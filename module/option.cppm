@@ -0,0 +1,64 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+// The 'opt.option' C++20 named module.
+// Exports the same API as the <opt/option.hpp> header.
+// The configuration macros (e.g. OPTION_USE_BUILTIN_TRAITS) must be defined when building the module itself.
+
+module;
+
+#include <opt/option.hpp>
+
+export module opt.option;
+
+export namespace opt {
+    using opt::option;
+    using opt::option_traits;
+    using opt::sentinel_option_traits;
+    using opt::enumeration_option_traits;
+#if OPTION_USE_BUILTIN_TRAITS && defined(OPTION_HAS_PFR)
+    using opt::padding_option_traits;
+#endif
+    using opt::is_option;
+    using opt::is_option_v;
+    using opt::option_tag;
+    using opt::none_t;
+    using opt::none;
+    using opt::bad_access;
+
+    using opt::sentinel;
+    using opt::sentinel_f;
+    using opt::member;
+    using opt::enforce;
+    using opt::bounded;
+
+    using opt::make_option;
+    using opt::zip;
+    using opt::zip_with;
+    using opt::option_cast;
+    using opt::from_nullable;
+    using opt::as_option;
+    using opt::from_std_optional;
+    using opt::to_std_optional;
+    using opt::swap;
+    using opt::flatten;
+    using opt::unzip;
+    using opt::get;
+    using opt::io;
+    using opt::at;
+    using opt::at_front;
+    using opt::at_back;
+    using opt::lookup;
+
+    using opt::operator|;
+    using opt::operator|=;
+    using opt::operator&;
+    using opt::operator^;
+    using opt::operator==;
+    using opt::operator!=;
+    using opt::operator<;
+    using opt::operator<=;
+    using opt::operator>;
+    using opt::operator>=;
+}
@@ -0,0 +1,378 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <opt/algorithm.hpp>
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstring>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <cstdint>
+#include <functional>
+
+#include "utils.hpp"
+
+namespace {
+
+TEST_SUITE_BEGIN("algorithm");
+
+enum class sentinel_enum : std::uint32_t { a, b, c, SENTINEL };
+
+template<class T, class Fn>
+std::vector<opt::option<T>> make_options(const std::size_t n, Fn&& fn) {
+    std::vector<opt::option<T>> result;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (i % 3 == 1 || i % 7 == 0) {
+            result.emplace_back();
+        } else {
+            result.emplace_back(fn(i));
+        }
+    }
+    return result;
+}
+
+template<class T>
+void check_mask(const std::vector<opt::option<T>>& options) {
+    const std::size_t n = options.size();
+    std::vector<std::uint64_t> bits((n + 63) / 64, ~std::uint64_t(0));
+    opt::has_value_mask(options.data(), n, bits.data());
+
+    std::size_t expected_count = 0;
+    for (std::size_t i = 0; i < n; ++i) {
+        const bool bit = ((bits[i / 64] >> (i % 64)) & 1) != 0;
+        CHECK_EQ(bit, options[i].has_value());
+        expected_count += options[i].has_value();
+    }
+    if (n % 64 != 0) {
+        CHECK_EQ(bits.back() >> (n % 64), 0);
+    }
+    CHECK_EQ(opt::count_engaged(options.data(), n), expected_count);
+}
+
+template<class T>
+void check_sizes() {
+    int x = 0;
+    for (const std::size_t n : {0u, 1u, 2u, 63u, 64u, 65u, 128u, 200u, 1000u}) {
+        CAPTURE(n);
+        check_mask(make_options<T>(n, [&](const std::size_t i) {
+            if constexpr (std::is_same_v<T, int*>) {
+                return &x + (i % 2);
+            } else
+            if constexpr (std::is_same_v<T, bool>) {
+                return i % 2 == 0;
+            } else
+            if constexpr (std::is_same_v<T, sentinel_enum>) {
+                return sentinel_enum(i % 3);
+            } else
+            if constexpr (std::is_floating_point_v<T>) {
+                // Other NaN values must not be considered empty
+                return i % 5 == 0 ? std::numeric_limits<T>::quiet_NaN() : T(i);
+            } else {
+                return T(i);
+            }
+        }));
+    }
+}
+
+TEST_CASE("has_value_mask") {
+    check_sizes<double>();
+    check_sizes<float>();
+    check_sizes<int*>();
+    check_sizes<bool>();
+    check_sizes<sentinel_enum>();
+    check_sizes<int>();
+}
+
+TEST_CASE("has_value_mask nested") {
+    std::vector<opt::option<opt::option<double>>> a(130);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        if (i % 2 == 0) {
+            a[i].emplace();
+        }
+        if (i % 4 == 0) {
+            a[i]->emplace(double(i));
+        }
+    }
+    check_mask(a);
+
+    int y = 0;
+    std::vector<opt::option<int&>> b(70);
+    for (std::size_t i = 0; i < b.size(); i += 3) {
+        b[i] = y;
+    }
+    check_mask(b);
+}
+
+template<class T>
+void check_reduce(const std::vector<opt::option<T>>& options) {
+    const opt::option<T>* const first = options.data();
+    const opt::option<T>* const last = first + options.size();
+
+    T expected_sum = T(0);
+    opt::option<T> expected_min;
+    opt::option<T> expected_max;
+    for (const opt::option<T>& x : options) {
+        if (x.has_value()) {
+            expected_sum = T(expected_sum + *x);
+            if (!expected_min || *x < *expected_min) { expected_min = *x; }
+            if (!expected_max || *expected_max < *x) { expected_max = *x; }
+        }
+    }
+    CHECK_EQ(opt::sum(first, last), expected_sum);
+    CHECK_EQ(opt::reduce_engaged(first, last, T(1), std::plus<T>{}), T(expected_sum + 1));
+    CHECK_EQ(opt::reduce_engaged(first, last, T(0), [](const T a, const T b) { return T(a + b); }), expected_sum);
+    CHECK_EQ(opt::min_engaged(first, last), expected_min);
+    CHECK_EQ(opt::max_engaged(first, last), expected_max);
+}
+
+template<class T>
+void check_reduce_sizes() {
+    for (const std::size_t n : {0u, 1u, 2u, 15u, 16u, 17u, 63u, 64u, 65u, 200u, 1000u}) {
+        CAPTURE(n);
+        check_reduce(make_options<T>(n, [](const std::size_t i) {
+            // Values that are exactly representable in floating-point types, so the order of the summation does not matter
+            const T value = T((i * 37) % 101);
+            return i % 2 == 0 ? value : T(T(0) - value);
+        }));
+    }
+    // All options are empty
+    check_reduce(std::vector<opt::option<T>>(100));
+}
+
+TEST_CASE("reduce") {
+    check_reduce_sizes<double>();
+    check_reduce_sizes<float>();
+    check_reduce_sizes<int>();
+    check_reduce_sizes<unsigned>();
+    check_reduce_sizes<std::int64_t>();
+    check_reduce_sizes<std::uint64_t>();
+    check_reduce_sizes<std::int16_t>();
+
+    const std::vector<opt::option<double>> a{1.5, opt::none, -2.5, opt::none, 4.0};
+    CHECK_EQ(opt::mean_engaged(a.data(), a.data() + a.size()), 1.0);
+    CHECK_EQ(opt::mean_engaged(a.data() + 1, a.data() + 2), opt::none);
+    CHECK_EQ(opt::reduce_engaged(a.data(), a.data() + a.size(), 0.5, std::plus<>{}), 3.5);
+
+    // Extreme values must not be lost when empty options are replaced with the identity value
+    const std::vector<opt::option<std::int64_t>> b(40, std::numeric_limits<std::int64_t>::max());
+    CHECK_EQ(opt::min_engaged(b.data(), b.data() + b.size()), std::numeric_limits<std::int64_t>::max());
+    const std::vector<opt::option<std::uint32_t>> c(40, 0u);
+    CHECK_EQ(opt::max_engaged(c.data(), c.data() + c.size()), 0u);
+
+    const std::vector<opt::option<sentinel_enum>> d = make_options<sentinel_enum>(150, [](const std::size_t i) { return sentinel_enum(i % 3); });
+    const std::size_t visited = opt::reduce_engaged(d.data(), d.data() + d.size(), std::size_t(0), [](const std::size_t acc, const sentinel_enum x) {
+        return acc + std::size_t(x) + 1;
+    });
+    std::size_t expected = 0;
+    for (const opt::option<sentinel_enum>& x : d) {
+        expected += x.has_value() ? std::size_t(*x) + 1 : 0;
+    }
+    CHECK_EQ(visited, expected);
+}
+
+struct point {
+    int x;
+    int y;
+    char z;
+
+    bool operator==(const point& other) const noexcept { return x == other.x && y == other.y && z == other.z; }
+};
+
+template<class T, class Fn>
+void check_value_or(Fn&& make_value) {
+    for (const std::size_t n : {0u, 1u, 3u, 4u, 8u, 15u, 16u, 17u, 33u, 64u, 100u}) {
+        CAPTURE(n);
+        const std::vector<opt::option<T>> options = make_options<T>(n, make_value);
+        const T dflt = make_value(n + 1);
+
+        // Not `std::vector`, because of `std::vector<bool>`
+        const std::unique_ptr<T[]> out(new T[n]);
+        opt::value_or_n(options.data(), n, dflt, out.get());
+        for (std::size_t i = 0; i < n; ++i) {
+            CHECK_EQ(out[i] == options[i].value_or(dflt), true);
+        }
+
+        std::vector<opt::option<T>> filled = options;
+        opt::fill_empty(filled.data(), n, dflt);
+        for (std::size_t i = 0; i < n; ++i) {
+            REQUIRE(filled[i].has_value());
+            CHECK_EQ(*filled[i] == options[i].value_or(dflt), true);
+        }
+    }
+}
+
+TEST_CASE("value_or_n, fill_empty") {
+    check_value_or<double>([](const std::size_t i) { return double(i) + 0.5; });
+    check_value_or<float>([](const std::size_t i) { return float(i) - 0.5f; });
+    check_value_or<int>([](const std::size_t i) { return int(i) * -3; });
+    check_value_or<std::uint64_t>([](const std::size_t i) { return std::uint64_t(i) << 40u; });
+    check_value_or<bool>([](const std::size_t i) { return i % 2 == 0; });
+    check_value_or<sentinel_enum>([](const std::size_t i) { return sentinel_enum(i % 3); });
+    int x = 0;
+    check_value_or<int*>([&](const std::size_t i) { return &x + (i % 2); });
+    check_value_or<point>([](const std::size_t i) { return point{int(i), -int(i), 'a'}; });
+    check_value_or<std::string>([](const std::size_t i) { return std::string(i % 40, 'a'); });
+}
+
+template<class T, class Fn>
+void check_compact(Fn&& make_value) {
+    for (const std::size_t n : {0u, 1u, 3u, 4u, 8u, 15u, 16u, 17u, 33u, 64u, 100u}) {
+        CAPTURE(n);
+        const std::vector<opt::option<T>> options = make_options<T>(n, make_value);
+
+        const std::unique_ptr<T[]> values(new T[n]);
+        std::vector<std::uint32_t> idx(n);
+        const std::size_t count = opt::compact(options.data(), n, values.get(), idx.data());
+        CHECK_EQ(count, opt::count_engaged(options.data(), n));
+
+        std::size_t k = 0;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (options[i].has_value()) {
+                REQUIRE(k < count);
+                CHECK_EQ(idx[k], i);
+                CHECK_EQ(values[k] == *options[i], true);
+                ++k;
+            }
+        }
+
+        std::vector<opt::option<T>> expanded(n, make_value(0));
+        opt::expand(values.get(), idx.data(), count, expanded.data(), n);
+        CHECK_EQ(expanded == options, true);
+    }
+}
+
+TEST_CASE("compact, expand") {
+    check_compact<double>([](const std::size_t i) { return double(i) + 0.5; });
+    check_compact<float>([](const std::size_t i) { return float(i) - 0.5f; });
+    check_compact<int>([](const std::size_t i) { return int(i) * -3; });
+    check_compact<std::uint64_t>([](const std::size_t i) { return std::uint64_t(i) << 40u; });
+    check_compact<bool>([](const std::size_t i) { return i % 2 == 0; });
+    check_compact<sentinel_enum>([](const std::size_t i) { return sentinel_enum(i % 3); });
+    int x = 0;
+    check_compact<int*>([&](const std::size_t i) { return &x + (i % 2); });
+    check_compact<point>([](const std::size_t i) { return point{int(i), -int(i), 'a'}; });
+    check_compact<std::string>([](const std::size_t i) { return std::string(i % 40, 'a'); });
+}
+
+template<class T>
+void check_reset(const T& value) {
+    for (const std::size_t n : {0u, 1u, 7u, 16u, 33u, 100u}) {
+        CAPTURE(n);
+        std::vector<opt::option<T>> options(n, value);
+        opt::reset_n(options.data(), n);
+        CHECK_EQ(opt::count_engaged(options.data(), n), 0u);
+        for (const opt::option<T>& x : options) {
+            CHECK_UNARY_FALSE(x.has_value());
+        }
+
+        alignas(opt::option<T>) unsigned char storage[100 * sizeof(opt::option<T>)];
+        std::memset(storage, 0xAB, sizeof(storage));
+        auto* const first = reinterpret_cast<opt::option<T>*>(storage);
+        CHECK_EQ(opt::uninitialized_default_construct_n(first, n), first + n);
+        for (std::size_t i = 0; i < n; ++i) {
+            CHECK_UNARY_FALSE(first[i].has_value());
+            first[i] = value;
+            CHECK_UNARY(first[i].has_value());
+            first[i].~option();
+        }
+    }
+}
+
+TEST_CASE("reset_n, uninitialized_default_construct_n") {
+    check_reset<double>(1.0);
+    check_reset<float>(2.0f);
+    check_reset<bool>(true);
+    check_reset<int>(3);
+    check_reset<std::int64_t>(4);
+    check_reset<sentinel_enum>(sentinel_enum::b);
+    int x = 0;
+    check_reset<int*>(&x);
+    check_reset<point>(point{1, 2, 'a'});
+    check_reset<opt::option<double>>(opt::option<double>{5.0});
+    check_reset<std::string>("abc");
+}
+
+TEST_CASE("empty_option_pattern") {
+    static_assert(opt::empty_option_pattern_v<int&> == 0);
+#if OPTION_USE_BUILTIN_TRAITS
+    const auto check_pattern = [](const auto& empty) {
+        using type = opt::empty_option_pattern<typename std::decay_t<decltype(empty)>::value_type>;
+        typename type::type bits;
+        std::memcpy(&bits, &empty, sizeof(bits));
+        CHECK_EQ(bits, type::value);
+    };
+    check_pattern(opt::option<double>{});
+    check_pattern(opt::option<float>{});
+    check_pattern(opt::option<bool>{});
+    check_pattern(opt::option<int*>{});
+    check_pattern(opt::option<sentinel_enum>{});
+
+    static_assert(sizeof(opt::empty_option_pattern_v<sentinel_enum>) == sizeof(sentinel_enum));
+    static_assert(opt::empty_option_pattern_v<sentinel_enum> == std::uint32_t(sentinel_enum::SENTINEL));
+#endif
+}
+
+template<class T>
+bool less_by_sort_key(const opt::option<T>& a, const opt::option<T>& b, const opt::nulls order) {
+    std::byte a_key[opt::sort_key_size<T>];
+    std::byte b_key[opt::sort_key_size<T>];
+    opt::sort_key(a, a_key, order);
+    opt::sort_key(b, b_key, order);
+    return std::memcmp(a_key, b_key, sizeof(a_key)) < 0;
+}
+
+template<class T>
+bool less_with_nulls(const opt::option<T>& a, const opt::option<T>& b, const opt::nulls order) {
+    if (a.has_value() && b.has_value()) {
+        return *a < *b;
+    }
+    return order == opt::nulls::first ? (!a.has_value() && b.has_value()) : (a.has_value() && !b.has_value());
+}
+
+template<class T>
+void check_sort(const std::vector<T>& values) {
+    std::vector<opt::option<T>> options = make_options<T>(values.size() * 2, [&](const std::size_t i) { return values[i % values.size()]; });
+
+    for (const opt::nulls order : {opt::nulls::first, opt::nulls::last}) {
+        for (const opt::option<T>& a : options) {
+            for (const opt::option<T>& b : options) {
+                CHECK_EQ(less_by_sort_key(a, b, order), less_with_nulls(a, b, order));
+            }
+        }
+
+        std::vector<opt::option<T>> sorted = options;
+        opt::radix_sort(sorted.data(), sorted.size(), order);
+
+        std::vector<opt::option<T>> expected = options;
+        std::stable_sort(expected.begin(), expected.end(), [&](const opt::option<T>& a, const opt::option<T>& b) {
+            return less_with_nulls(a, b, order);
+        });
+        CHECK_EQ(sorted == expected, true);
+    }
+}
+
+TEST_CASE("sort_key, radix_sort") {
+    check_sort<int>({5, -3, 0, 1000000, -1000000, 7, (std::numeric_limits<int>::min)(), (std::numeric_limits<int>::max)(), 5});
+    check_sort<unsigned>({5u, 3u, 0u, 1000000u, 0xFFFFFFFFu, 256u, 255u});
+    check_sort<std::int64_t>({-1, 1, std::int64_t(1) << 40, -(std::int64_t(1) << 40), 0});
+    check_sort<std::int16_t>({-1, 1, 300, -300, 0});
+    check_sort<std::uint8_t>({1, 0, 255, 128, 127});
+    check_sort<bool>({true, false});
+    check_sort<sentinel_enum>({sentinel_enum::c, sentinel_enum::a, sentinel_enum::b});
+    check_sort<double>({1.5, -2.5, 0.0, 1e300, -1e300, std::numeric_limits<double>::infinity(), -std::numeric_limits<double>::infinity(), 1e-310});
+    check_sort<float>({1.5f, -2.5f, 0.0f, 1e30f, -1e30f, std::numeric_limits<float>::infinity(), -0.5f});
+
+    // Only empty options
+    std::vector<opt::option<int>> empty(10);
+    opt::radix_sort(empty.data(), empty.size(), opt::nulls::last);
+    CHECK_EQ(opt::count_engaged(empty.data(), empty.size()), 0u);
+    opt::radix_sort(empty.data(), 0);
+}
+
+TEST_SUITE_END();
+
+}
@@ -0,0 +1,100 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <opt/aligned_ptr.hpp>
+#include <cstdint>
+#include <tuple>
+
+#include "utils.hpp"
+
+namespace {
+
+TEST_SUITE_BEGIN("opt::aligned_ptr");
+
+struct node {
+    opt::option<opt::tagged_ptr<node, 1>> left;
+    opt::option<opt::aligned_ptr<node, alignof(void*)>> right;
+    int value;
+};
+
+TEST_CASE("aligned_ptr") {
+    using traits = opt::option_traits<opt::aligned_ptr<std::uint32_t>>;
+    CHECK_EQ(sizeof(opt::option<opt::aligned_ptr<std::uint32_t>>), sizeof(std::uint32_t*));
+    CHECK_EQ(traits::max_level, std::uintmax_t(std::uintptr_t(-1)) - std::uintmax_t(std::uintptr_t(-1) >> 2));
+
+    std::uint32_t a = 1;
+    opt::aligned_ptr<std::uint32_t> b{&a};
+    CHECK_EQ(b.get(), &a);
+    CHECK_EQ(*b, 1);
+    CHECK_GE(traits::get_level(&b), traits::max_level);
+    b = nullptr;
+    CHECK_GE(traits::get_level(&b), traits::max_level);
+    CHECK_UNARY_FALSE(b);
+
+    for (const std::uintmax_t level : {std::uintmax_t(0), std::uintmax_t(1), std::uintmax_t(2), std::uintmax_t(3), std::uintmax_t(1000), traits::max_level - 1}) {
+        traits::set_level(&b, level);
+        CHECK_EQ(traits::get_level(&b), level);
+    }
+
+    opt::option<opt::aligned_ptr<std::uint32_t>> c;
+    CHECK_UNARY_FALSE(c.has_value());
+    c = opt::aligned_ptr<std::uint32_t>{&a};
+    CHECK_EQ(c->get(), &a);
+    c = opt::aligned_ptr<std::uint32_t>{nullptr};
+    CHECK_UNARY(c.has_value());
+
+    opt::option<opt::option<opt::option<opt::aligned_ptr<std::uint32_t>>>> d;
+    CHECK_EQ(sizeof(d), sizeof(std::uint32_t*));
+    CHECK_UNARY_FALSE(d.has_value());
+    d.emplace();
+    CHECK_UNARY(d.has_value());
+    CHECK_UNARY_FALSE(d->has_value());
+}
+
+TEST_CASE("tagged_ptr") {
+    CHECK_EQ(sizeof(opt::tagged_ptr<std::uint64_t, 3>), sizeof(std::uint64_t*));
+    CHECK_EQ(sizeof(opt::option<opt::tagged_ptr<std::uint64_t, 3>>), sizeof(std::uint64_t*));
+
+    alignas(8) std::uint64_t a = 5;
+    opt::tagged_ptr<std::uint64_t, 3> b{&a, 6};
+    CHECK_EQ(b.get(), &a);
+    CHECK_EQ(b.tag(), 6u);
+    CHECK_EQ(*b, 5);
+    b.set_tag(1);
+    CHECK_EQ(b.get(), &a);
+    CHECK_EQ(b.tag(), 1u);
+    b.set(nullptr);
+    CHECK_EQ(b.get(), nullptr);
+    CHECK_EQ(b.tag(), 1u);
+    CHECK_UNARY_FALSE(b);
+
+    opt::option<opt::tagged_ptr<std::uint64_t, 3>> c;
+    CHECK_UNARY_FALSE(c.has_value());
+    c.emplace(&a, 7u);
+    CHECK_EQ(c->get(), &a);
+    CHECK_EQ(c->tag(), 7u);
+    c.emplace(nullptr);
+    CHECK_UNARY(c.has_value());
+    CHECK_EQ(c->tag(), 0u);
+    c.reset();
+    CHECK_UNARY_FALSE(c.has_value());
+}
+
+TEST_CASE("intrusive node") {
+    CHECK_EQ(sizeof(node), sizeof(std::tuple<node*, node*, int>));
+
+    node root{};
+    node child{};
+    root.left.emplace(&child, 1u);
+    CHECK_EQ(root.left->get(), &child);
+    CHECK_EQ(root.left->tag(), 1u);
+    CHECK_UNARY_FALSE(root.right.has_value());
+    root.right = opt::aligned_ptr<node, alignof(void*)>{&child};
+    CHECK_EQ(root.right->get(), &child);
+}
+
+TEST_SUITE_END();
+
+}
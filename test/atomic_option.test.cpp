@@ -0,0 +1,98 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <opt/atomic_option.hpp>
+#include <cstdint>
+
+#include "utils.hpp"
+
+namespace {
+
+TEST_SUITE_BEGIN("opt::atomic_option");
+
+enum class id : std::uint32_t { a, b, SENTINEL };
+
+TEST_CASE("lock free") {
+    CHECK_UNARY(opt::atomic_option<int*>::is_always_lock_free);
+    CHECK_UNARY(opt::atomic_option<double>::is_always_lock_free);
+    CHECK_UNARY(opt::atomic_option<float>::is_always_lock_free);
+    CHECK_UNARY(opt::atomic_option<id>::is_always_lock_free);
+    CHECK_UNARY(opt::atomic_option<opt::sentinel<int, -1>>::is_always_lock_free);
+    CHECK_UNARY(opt::atomic_option<int*>{}.is_lock_free());
+}
+
+TEST_CASE("load/store") {
+    int x = 1;
+    int y = 2;
+    opt::atomic_option<int*> a;
+    CHECK_EQ(a.load(), opt::none);
+    CHECK_UNARY_FALSE(a.has_value());
+
+    a.store(&x);
+    CHECK_EQ(a.load(), &x);
+    CHECK_UNARY(a.has_value());
+    a = opt::option<int*>{&y};
+    CHECK_EQ(opt::option<int*>(a), &y);
+    a.reset();
+    CHECK_EQ(a.load(std::memory_order_acquire), opt::none);
+
+    opt::atomic_option<double> b{1.5};
+    CHECK_EQ(b.load(), 1.5);
+    b.store(opt::none, std::memory_order_release);
+    CHECK_EQ(b.load(), opt::none);
+}
+
+TEST_CASE("exchange/take") {
+    opt::atomic_option<id> a{id::a};
+    CHECK_EQ(a.exchange(id::b), id::a);
+    CHECK_EQ(a.load(), id::b);
+    CHECK_EQ(a.take(), id::b);
+    CHECK_EQ(a.load(), opt::none);
+    CHECK_EQ(a.take(), opt::none);
+    CHECK_EQ(a.exchange(opt::none), opt::none);
+}
+
+TEST_CASE("compare_exchange") {
+    opt::atomic_option<float> a;
+
+    opt::option<float> expected{1.f};
+    CHECK_UNARY_FALSE(a.compare_exchange_strong(expected, 2.f));
+    CHECK_EQ(expected, opt::none);
+
+    CHECK_UNARY(a.compare_exchange_strong(expected, 2.f));
+    CHECK_EQ(a.load(), 2.f);
+
+    expected = 2.f;
+    while (!a.compare_exchange_weak(expected, opt::none, std::memory_order_acq_rel)) {}
+    CHECK_EQ(a.load(), opt::none);
+}
+
+TEST_CASE("try_emplace") {
+    opt::atomic_option<opt::sentinel<int, -1>> a;
+    CHECK_UNARY(a.try_emplace(5));
+    CHECK_EQ(a.load(), 5);
+    CHECK_UNARY_FALSE(a.try_emplace(6));
+    CHECK_EQ(a.load(), 5);
+    (void)a.take();
+    CHECK_UNARY(a.try_emplace(7));
+    CHECK_EQ(a.load(), 7);
+}
+
+#if OPTION_IS_CXX20 && defined(__cpp_lib_atomic_wait)
+TEST_CASE("wait/notify") {
+    opt::atomic_option<int*> a;
+    int x = 0;
+    a.store(&x);
+    // Does not block because the contained option is not equal to `opt::none`
+    a.wait(opt::none);
+    a.notify_one();
+    a.notify_all();
+    CHECK_EQ(a.load(), &x);
+}
+#endif
+
+TEST_SUITE_END();
+
+}
@@ -0,0 +1,162 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <opt/niche_hash_map.hpp>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "utils.hpp"
+
+namespace {
+
+TEST_SUITE_BEGIN("opt::niche_hash_map");
+
+TEST_CASE("pointer keys") {
+    std::vector<int> storage(1000);
+    opt::niche_hash_map<int*, int> a;
+    CHECK_UNARY(a.empty());
+    CHECK_EQ(a.find(storage.data()), opt::none);
+
+    for (int i = 0; i < 1000; ++i) {
+        CHECK_UNARY(a.try_emplace(&storage[std::size_t(i)], i).second);
+    }
+    CHECK_EQ(a.size(), 1000);
+    CHECK_UNARY_FALSE(a.try_emplace(&storage[0], 5).second);
+
+    for (int i = 0; i < 1000; ++i) {
+        CHECK_EQ(a.find(&storage[std::size_t(i)]), i);
+    }
+    for (int i = 0; i < 1000; i += 2) {
+        CHECK_UNARY(a.erase(&storage[std::size_t(i)]));
+    }
+    CHECK_UNARY_FALSE(a.erase(&storage[0]));
+    CHECK_EQ(a.size(), 500);
+    for (int i = 0; i < 1000; ++i) {
+        CHECK_EQ(a.contains(&storage[std::size_t(i)]), i % 2 == 1);
+    }
+
+    // Reuse tombstones
+    for (int i = 0; i < 1000; i += 2) {
+        a[&storage[std::size_t(i)]] = -i;
+    }
+    CHECK_EQ(a.size(), 1000);
+    CHECK_EQ(a.find(&storage[10]), -10);
+
+    *a.find(&storage[1]) = 100;
+    CHECK_EQ(a.find(&storage[1]), 100);
+    CHECK_EQ(a.take(&storage[1]), 100);
+    CHECK_EQ(a.take(&storage[1]), opt::none);
+    CHECK_UNARY_FALSE(a.insert_or_assign(&storage[2], 7));
+    CHECK_UNARY(a.insert_or_assign(&storage[1], 8));
+    CHECK_EQ(a.find(&storage[2]), 7);
+
+    std::size_t count = 0;
+    long long sum = 0;
+    for (auto [key, value] : a) {
+        CHECK_EQ(a.find(key), value);
+        sum += value;
+        ++count;
+    }
+    CHECK_EQ(count, a.size());
+
+    const auto& b = a;
+    CHECK_EQ(b.find(&storage[2]), 7);
+
+    a.clear();
+    CHECK_UNARY(a.empty());
+    CHECK_EQ(a.find(&storage[2]), opt::none);
+}
+
+TEST_CASE("string keys") {
+    opt::niche_hash_map<std::string_view, std::string> a{{"a", "1"}, {"b", "2"}};
+    CHECK_EQ(a.size(), 2);
+    CHECK_EQ(a.find("a"), "1");
+    CHECK_EQ(a.find("c"), opt::none);
+
+    std::vector<std::string> keys;
+    for (int i = 0; i < 300; ++i) {
+        keys.push_back(std::to_string(i));
+    }
+    for (const auto& key : keys) {
+        a[key] = key + "!";
+    }
+    CHECK_EQ(a.find("150"), "150!");
+
+    opt::niche_hash_map<std::string_view, std::string> b{a};
+    CHECK_EQ(b.size(), a.size());
+    CHECK_EQ(b.find("299"), "299!");
+    b.erase("299");
+    CHECK_EQ(a.find("299"), "299!");
+
+    opt::niche_hash_map<std::string_view, std::string> c{std::move(b)};
+    CHECK_EQ(c.find("299"), opt::none);
+    CHECK_EQ(c.find("298"), "298!");
+
+    swap(a, c);
+    CHECK_EQ(a.find("299"), opt::none);
+    CHECK_EQ(c.find("299"), "299!");
+}
+
+TEST_CASE("aliased arguments at the growth threshold") {
+    opt::niche_hash_map<std::string_view, std::string> a;
+    const std::string_view keys[] = {"k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7", "k8"};
+    for (std::size_t i = 0; i < 7; ++i) {
+        a.try_emplace(keys[i], std::string(32, char('a' + i)));
+    }
+    const std::size_t capacity = a.capacity();
+
+    // The key is already present, so the table doesn't grow
+    const auto first = *a.begin();
+    const std::string expected = first.second + "!";
+    a[first.first] += "!";
+    CHECK_EQ(a.capacity(), capacity);
+    CHECK_EQ(a.size(), 7);
+    CHECK_EQ(a.find(first.first), expected);
+
+    CHECK_UNARY(a.try_emplace(keys[7], a.find(keys[1]).get()).second);
+    CHECK_GT(a.capacity(), capacity);
+    CHECK_EQ(a.find(keys[7]), std::string(32, 'b'));
+    CHECK_EQ(a.find(keys[1]), std::string(32, 'b'));
+
+    opt::niche_hash_set<std::string_view> b;
+    for (std::size_t i = 0; i < 7; ++i) {
+        b.insert(keys[i]);
+    }
+    const std::size_t set_capacity = b.capacity();
+    CHECK_UNARY_FALSE(b.insert(*b.begin()));
+    CHECK_EQ(b.capacity(), set_capacity);
+    CHECK_UNARY(b.insert(keys[8]));
+    CHECK_UNARY(b.contains(keys[8]));
+}
+
+TEST_CASE("set") {
+    std::vector<double> storage(200);
+    opt::niche_hash_set<const double*> a;
+    for (const double& x : storage) {
+        CHECK_UNARY(a.insert(&x));
+    }
+    CHECK_UNARY_FALSE(a.insert(&storage[0]));
+    CHECK_EQ(a.size(), 200);
+    CHECK_EQ(a.find(&storage[5]), &storage[5]);
+    CHECK_UNARY(a.erase(&storage[5]));
+    CHECK_EQ(a.find(&storage[5]), opt::none);
+
+    std::size_t count = 0;
+    for (const double* x : a) {
+        CHECK_UNARY(a.contains(x));
+        ++count;
+    }
+    CHECK_EQ(count, 199);
+
+    opt::niche_hash_set<std::string> b{"abc", "def"};
+    CHECK_UNARY(b.contains("abc"));
+    CHECK_UNARY_FALSE(b.contains("xyz"));
+    CHECK_EQ(b.find("def"), "def");
+}
+
+TEST_SUITE_END();
+
+}
@@ -0,0 +1,168 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <opt/niche_variant.hpp>
+#include <string>
+#include <memory>
+#include <utility>
+#include <cstdint>
+#include <cstring>
+
+#include "utils.hpp"
+
+#if OPTION_USE_BUILTIN_TRAITS && defined(OPTION_HAS_PFR)
+struct padded_carrier { std::uint64_t x; std::uint8_t y; };
+template<>
+struct opt::option_traits<padded_carrier> : opt::padding_option_traits<padded_carrier> {};
+#endif
+
+namespace {
+
+TEST_SUITE_BEGIN("opt::niche_variant");
+
+struct empty1 {
+    bool operator==(const empty1&) const noexcept { return true; }
+};
+struct empty2 {
+    bool operator==(const empty2&) const noexcept { return true; }
+};
+
+TEST_CASE("size") {
+    CHECK_EQ(sizeof(opt::niche_variant<std::string, empty1, empty2>), sizeof(std::string));
+    CHECK_UNARY(opt::niche_variant<std::string, empty1, empty2>::is_niche_packed);
+    CHECK_EQ(sizeof(opt::niche_variant<empty1, double, empty2>), sizeof(double));
+    CHECK_EQ(sizeof(opt::niche_variant<int*, empty1>), sizeof(int*));
+    CHECK_UNARY_FALSE(opt::niche_variant<int, empty1>::is_niche_packed);
+    CHECK_UNARY_FALSE(opt::niche_variant<int*, double>::is_niche_packed);
+    CHECK_EQ(sizeof(opt::niche_variant<int, empty1>), 2 * sizeof(int));
+
+    // The unused states of the carrier alternative are available for opt::option
+    CHECK_EQ(sizeof(opt::option<opt::niche_variant<std::string, empty1, empty2>>), sizeof(std::string));
+    CHECK_EQ(sizeof(opt::option<opt::niche_variant<int, empty1>>), 2 * sizeof(int));
+}
+
+TEST_CASE("packed") {
+    using variant = opt::niche_variant<std::string, empty1, empty2>;
+    variant a;
+    CHECK_EQ(a.index(), 0);
+    CHECK_EQ(a.get<0>(), "");
+
+    a = std::string(100, 'a');
+    CHECK_EQ(a.index(), 0);
+    CHECK_EQ(a.get<std::string>(), std::string(100, 'a'));
+    CHECK_UNARY(a.holds_alternative<std::string>());
+
+    a.emplace<2>();
+    CHECK_EQ(a.index(), 2);
+    CHECK_UNARY(a.holds_alternative<empty2>());
+    CHECK_EQ(a.get_if<0>(), opt::none);
+    CHECK_UNARY(a.get_if<empty2>().has_value());
+
+    a = empty1{};
+    CHECK_EQ(a.index(), 1);
+
+    variant b{std::in_place_index<0>, 3u, 'b'};
+    CHECK_EQ(b.get<0>(), "bbb");
+    variant c{b};
+    CHECK_EQ(c.get<0>(), "bbb");
+    CHECK_UNARY(b == c);
+    CHECK_UNARY(a != c);
+
+    swap(a, c);
+    CHECK_EQ(a.index(), 0);
+    CHECK_EQ(c.index(), 1);
+
+    c = a;
+    CHECK_EQ(c.get<0>(), "bbb");
+    c = variant{empty2{}};
+    CHECK_EQ(c.index(), 2);
+
+    const std::size_t length = b.visit([](const auto& x) -> std::size_t {
+        if constexpr (std::is_same_v<std::decay_t<decltype(x)>, std::string>) {
+            return x.size();
+        } else {
+            return 0;
+        }
+    });
+    CHECK_EQ(length, 3);
+
+    opt::option<variant> d;
+    CHECK_EQ(d, opt::none);
+    d.emplace(empty2{});
+    CHECK_UNARY(d.has_value());
+    CHECK_EQ(d->index(), 2);
+    d.emplace(std::string("x"));
+    CHECK_EQ(d->get<0>(), "x");
+    d.reset();
+    CHECK_UNARY_FALSE(d.has_value());
+}
+
+TEST_CASE("carrier in the middle") {
+    using variant = opt::niche_variant<empty1, double, empty2>;
+    variant a;
+    CHECK_EQ(a.index(), 0);
+    a = 1.5;
+    CHECK_EQ(a.index(), 1);
+    CHECK_EQ(a.get<1>(), 1.5);
+    a.emplace<2>();
+    CHECK_EQ(a.index(), 2);
+    a.emplace<0>();
+    CHECK_EQ(a.index(), 0);
+}
+
+#if OPTION_USE_BUILTIN_TRAITS && defined(OPTION_HAS_PFR)
+TEST_CASE("carrier with padding bytes") {
+    using variant = opt::niche_variant<padded_carrier, empty1, empty2>;
+    CHECK_UNARY(variant::is_niche_packed);
+
+    // A value whose padding bytes hold the level of the `empty2` alternative
+    const variant empty{empty2{}};
+    padded_carrier stale{};
+    std::memcpy(static_cast<void*>(&stale), &empty, sizeof(stale));
+    stale.x = 5u;
+    stale.y = 6u;
+
+    variant a{padded_carrier{1u, 2u}};
+    a = stale;
+    CHECK_EQ(a.index(), 0);
+    CHECK_EQ(a.get<0>().x, 5u);
+    a = padded_carrier{7u, 8u};
+    a = std::as_const(stale);
+    CHECK_EQ(a.index(), 0);
+    CHECK_EQ(a.get<0>().y, 6u);
+
+    variant b{stale};
+    CHECK_EQ(b.index(), 0);
+    b = a;
+    CHECK_EQ(b.index(), 0);
+    CHECK_EQ(b.get<0>().x, 5u);
+    b = empty1{};
+    CHECK_EQ(b.index(), 1);
+    b = std::move(a);
+    CHECK_EQ(b.index(), 0);
+    CHECK_EQ(b.get<0>().y, 6u);
+}
+#endif
+
+TEST_CASE("separate discriminant") {
+    using variant = opt::niche_variant<int, std::unique_ptr<int>, empty1>;
+    CHECK_UNARY_FALSE(variant::is_niche_packed);
+    variant a{std::make_unique<int>(5)};
+    CHECK_EQ(a.index(), 1);
+    CHECK_EQ(*a.get<1>(), 5);
+    variant b{std::move(a)};
+    CHECK_EQ(*b.get<1>(), 5);
+    b = 1;
+    CHECK_EQ(b.get<0>(), 1);
+
+    opt::option<variant> c{std::in_place, std::in_place_index<2>};
+    CHECK_EQ(c->index(), 2);
+    c.reset();
+    CHECK_UNARY_FALSE(c.has_value());
+}
+
+TEST_SUITE_END();
+
+}
@@ -0,0 +1,88 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <opt/option_tuple.hpp>
+#include <cstdint>
+#include <string>
+#include <memory>
+#include <tuple>
+
+#include "utils.hpp"
+
+namespace {
+
+TEST_SUITE_BEGIN("opt::option_tuple");
+
+TEST_CASE("size") {
+    using tuple = opt::option_tuple<std::int32_t, std::int32_t, std::uint16_t, std::uint16_t, std::int32_t, std::int32_t>;
+    CHECK_EQ(sizeof(tuple), 4 * sizeof(std::int32_t) + 2 * sizeof(std::uint16_t) + sizeof(std::int32_t));
+    CHECK_UNARY_FALSE(tuple::is_flag_free<0>);
+    CHECK_LT(sizeof(tuple), sizeof(std::tuple<
+        opt::option<std::int32_t>, opt::option<std::int32_t>, opt::option<std::uint16_t>,
+        opt::option<std::uint16_t>, opt::option<std::int32_t>, opt::option<std::int32_t>>));
+
+    using niche_tuple = opt::option_tuple<double, float, int*>;
+    CHECK_EQ(sizeof(niche_tuple), sizeof(std::tuple<double, float, int*>));
+    CHECK_UNARY(niche_tuple::is_flag_free<0>);
+    CHECK_UNARY(niche_tuple::is_flag_free<2>);
+
+    using mixed = opt::option_tuple<double, std::int32_t, std::int32_t>;
+    CHECK_EQ(sizeof(mixed), sizeof(std::tuple<double, std::int32_t, std::int32_t, unsigned char>));
+}
+
+TEST_CASE("get/emplace/reset") {
+    opt::option_tuple<int, double, std::string, bool, long> a;
+    CHECK_EQ(a.count(), 0);
+    CHECK_EQ(a.get<0>(), opt::none);
+    CHECK_EQ(a.get<1>(), opt::none);
+
+    a.emplace<0>(1);
+    a.emplace<1>(2.5);
+    a.emplace<2>(100u, 'a');
+    CHECK_EQ(a.count(), 3);
+    CHECK_EQ(a.get<0>(), 1);
+    CHECK_EQ(a.get<1>(), 2.5);
+    CHECK_EQ(*a.get<2>(), std::string(100, 'a'));
+    CHECK_UNARY_FALSE(a.has_value<3>());
+
+    *a.get<0>() = 5;
+    CHECK_EQ(a.get<0>(), 5);
+
+    auto b = a;
+    CHECK_UNARY(a == b);
+    b.reset<0>();
+    CHECK_UNARY(a != b);
+    CHECK_EQ(b.get<0>(), opt::none);
+    CHECK_EQ(b.count(), 2);
+
+    b = a;
+    CHECK_UNARY(a == b);
+    b.emplace<4>(4L);
+    a = std::move(b);
+    CHECK_EQ(a.get<4>(), 4L);
+    CHECK_EQ(*a.get<2>(), std::string(100, 'a'));
+
+    const opt::option<std::string> s = a.take<2>();
+    CHECK_EQ(s, std::string(100, 'a'));
+    CHECK_UNARY_FALSE(a.has_value<2>());
+
+    a.reset();
+    CHECK_EQ(a.count(), 0);
+}
+
+TEST_CASE("construct from options") {
+    opt::option_tuple<int, std::unique_ptr<int>, float> a{opt::option<int>{1}, opt::option<std::unique_ptr<int>>{std::make_unique<int>(2)}, opt::option<float>{}};
+    CHECK_EQ(a.get<0>(), 1);
+    CHECK_EQ(**a.get<1>(), 2);
+    CHECK_EQ(a.get<2>(), opt::none);
+
+    const auto b = std::move(a);
+    CHECK_EQ(**b.get<1>(), 2);
+    CHECK_EQ(b.get<0>(), 1);
+}
+
+TEST_SUITE_END();
+
+}
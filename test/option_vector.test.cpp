@@ -0,0 +1,185 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <opt/option_vector.hpp>
+#include <string>
+#include <memory>
+
+#include "utils.hpp"
+
+namespace {
+
+TEST_SUITE_BEGIN("opt::option_vector");
+
+TEST_CASE("layout") {
+    CHECK_UNARY(opt::option_vector<int>::is_bitmap_packed);
+    CHECK_UNARY(opt::option_vector<std::unique_ptr<int>>::is_bitmap_packed == (opt::option_traits<std::unique_ptr<int>>::max_level == 0));
+    CHECK_UNARY_FALSE(opt::option_vector<double>::is_bitmap_packed);
+    CHECK_UNARY_FALSE(opt::option_vector<int*>::is_bitmap_packed);
+}
+
+TEST_CASE("int") {
+    opt::option_vector<int> a;
+    CHECK_UNARY(a.empty());
+    CHECK_EQ(a.size(), 0);
+
+    a.push_back(1);
+    a.push_back(opt::none);
+    a.push_back(opt::option<int>{3});
+    a.push_back(opt::option<int>{});
+    CHECK_EQ(a.size(), 4);
+    CHECK_EQ(a.count(), 2);
+
+    CHECK_EQ(a[0], 1);
+    CHECK_EQ(a[1], opt::none);
+    CHECK_EQ(a[2], 3);
+    CHECK_EQ(a[3], opt::none);
+    CHECK_UNARY(a.has_value(0));
+    CHECK_UNARY_FALSE(a.has_value(1));
+
+    *a[0] = 10;
+    CHECK_EQ(a[0], 10);
+
+    a.reset(0);
+    CHECK_EQ(a[0], opt::none);
+    CHECK_EQ(a.count(), 1);
+
+    CHECK_EQ(a.emplace(1, 20), 20);
+    CHECK_EQ(a[1], 20);
+    CHECK_EQ(a.emplace(1, 21), 21);
+    CHECK_EQ(a[1], 21);
+    CHECK_EQ(a.count(), 2);
+
+    a.pop_back();
+    CHECK_EQ(a.size(), 3);
+    a.pop_back();
+    CHECK_EQ(a.size(), 2);
+    CHECK_EQ(a.count(), 1);
+
+    const auto& b = a;
+    CHECK_EQ(b[1], 21);
+    CHECK_EQ(b[0], opt::none);
+}
+
+TEST_CASE("growth") {
+    opt::option_vector<int> a;
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 3 == 0) {
+            a.push_back(opt::none);
+        } else {
+            a.emplace_back(i);
+        }
+    }
+    CHECK_EQ(a.size(), 1000);
+    CHECK_EQ(a.count(), 666);
+    for (int i = 0; i < 1000; ++i) {
+        if (i % 3 == 0) {
+            CHECK_EQ(a[std::size_t(i)], opt::none);
+        } else {
+            CHECK_EQ(a[std::size_t(i)], i);
+        }
+    }
+    a.resize(10);
+    CHECK_EQ(a.size(), 10);
+    CHECK_EQ(a.count(), 6);
+    a.resize(100);
+    CHECK_EQ(a.count(), 6);
+    CHECK_EQ(a[99], opt::none);
+    a.shrink_to_fit();
+    CHECK_EQ(a.capacity(), 100);
+    a.clear();
+    CHECK_UNARY(a.empty());
+    CHECK_EQ(a.count(), 0);
+}
+
+TEST_CASE("non-trivial") {
+    opt::option_vector<std::string> a{std::string{"abc"}, opt::none, std::string{"def"}};
+    CHECK_EQ(a.size(), 3);
+    CHECK_EQ(a[0], "abc");
+    CHECK_EQ(a[1], opt::none);
+    CHECK_EQ(a[2], "def");
+
+    for (int i = 0; i < 200; ++i) {
+        a.push_back(std::string(std::size_t(i), 'x'));
+    }
+    CHECK_EQ(a[0], "abc");
+    CHECK_EQ(a[202], std::string(199, 'x'));
+
+    opt::option_vector<std::string> b{a};
+    CHECK_EQ(b.size(), a.size());
+    CHECK_EQ(b[2], "def");
+    CHECK_EQ(b[1], opt::none);
+
+    opt::option_vector<std::string> c{std::move(b)};
+    CHECK_EQ(c[0], "abc");
+    CHECK_UNARY(b.empty()); // NOLINT(bugprone-use-after-move)
+
+    c.reset(0);
+    c.emplace(1, 3u, 'y');
+    CHECK_EQ(c[1], "yyy");
+    b = c;
+    CHECK_EQ(b[0], opt::none);
+    CHECK_EQ(b[1], "yyy");
+
+    swap(a, b);
+    CHECK_EQ(a[1], "yyy");
+    CHECK_EQ(b[0], "abc");
+}
+
+TEST_CASE("niche") {
+    opt::option_vector<double> a;
+    a.push_back(1.5);
+    a.push_back(opt::none);
+    CHECK_EQ(a[0], 1.5);
+    CHECK_EQ(a[1], opt::none);
+    a.emplace(1, 2.5);
+    CHECK_EQ(a[1], 2.5);
+    a.reset(0);
+    CHECK_EQ(a[0], opt::none);
+    CHECK_EQ(a.count(), 1);
+
+    int x = 1;
+    opt::option_vector<int*> b(3);
+    CHECK_EQ(b.count(), 0);
+    b.emplace(2, &x);
+    CHECK_EQ(b[2], &x);
+    CHECK_EQ(**b[2], 1);
+}
+
+TEST_CASE("self-aliasing push at capacity") {
+    int x = 1;
+    opt::option_vector<int*> a;
+    a.push_back(&x);
+    a.shrink_to_fit();
+    CHECK_EQ(a.size(), a.capacity());
+    a.push_back(*a[0]);
+    CHECK_EQ(a[1], &x);
+    a.shrink_to_fit();
+    a.emplace_back(a[1].get());
+    CHECK_EQ(a[2], &x);
+
+    opt::option_vector<std::string> b;
+    b.push_back(std::string(32, 'a'));
+    while (b.size() < b.capacity()) {
+        b.push_back(opt::none);
+    }
+    const std::size_t capacity = b.capacity();
+    b.push_back(*b[0]);
+    CHECK_UNARY(b.capacity() > capacity);
+    CHECK_EQ(b[0], std::string(32, 'a'));
+    CHECK_EQ(b[capacity], std::string(32, 'a'));
+
+    while (b.size() < b.capacity()) {
+        b.push_back(opt::none);
+    }
+    const std::size_t size = b.size();
+    b.emplace_back(b[capacity].get());
+    CHECK_EQ(b[capacity], std::string(32, 'a'));
+    CHECK_EQ(b[size], std::string(32, 'a'));
+}
+
+TEST_SUITE_END();
+
+}
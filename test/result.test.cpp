@@ -0,0 +1,142 @@
+// Copyright 2024.
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at https://www.boost.org/LICENSE_1_0.txt)
+
+#include <doctest/doctest.h>
+#include <opt/result.hpp>
+#include <string>
+#include <memory>
+
+#include "utils.hpp"
+
+namespace {
+
+TEST_SUITE_BEGIN("opt::result");
+
+enum class error_code : std::uint8_t { not_found, timed_out, invalid };
+enum class sentinel_error : int { a, b, SENTINEL };
+struct empty_error {
+    bool operator==(const empty_error&) const noexcept { return true; }
+};
+
+TEST_CASE("size") {
+    CHECK_UNARY(opt::result<int*, error_code>::is_niche_packed);
+    CHECK_EQ(sizeof(opt::result<int*, error_code>), sizeof(int*));
+    CHECK_EQ(sizeof(opt::result<double, std::uint8_t>), sizeof(double));
+    CHECK_EQ(sizeof(opt::result<double, sentinel_error>), sizeof(double));
+    CHECK_UNARY_FALSE(opt::result<double, std::uint16_t>::is_niche_packed);
+    CHECK_EQ(sizeof(opt::result<float, empty_error>), sizeof(float));
+    CHECK_EQ(sizeof(opt::result<bool, bool>), sizeof(bool));
+    CHECK_EQ(sizeof(opt::result<bool, error_code>), sizeof(bool));
+    CHECK_UNARY_FALSE(opt::result<bool, std::uint8_t>::is_niche_packed);
+    CHECK_UNARY_FALSE(opt::result<int, error_code>::is_niche_packed);
+    CHECK_UNARY_FALSE(opt::result<int*, std::string>::is_niche_packed);
+
+    CHECK_EQ(sizeof(opt::option<opt::result<int*, error_code>>), sizeof(int*));
+    CHECK_EQ(sizeof(opt::option<opt::result<int, error_code>>), sizeof(opt::result<int, error_code>));
+}
+
+TEST_CASE("packed") {
+    int x = 1;
+    using res = opt::result<int*, error_code>;
+
+    res a{&x};
+    CHECK_UNARY(a.has_value());
+    CHECK_EQ(*a, &x);
+    CHECK_EQ(a.value(), &x);
+
+    res b{opt::in_place_error, error_code::timed_out};
+    CHECK_UNARY_FALSE(b.has_value());
+    CHECK_EQ(b.error(), error_code::timed_out);
+    CHECK_EQ(b.value_or(nullptr), nullptr);
+    CHECK_EQ(b.err(), error_code::timed_out);
+    CHECK_EQ(b.ok(), opt::none);
+    CHECK_EQ(a.ok(), &x);
+
+    a = b;
+    CHECK_EQ(a.error(), error_code::timed_out);
+    CHECK_UNARY(a == b);
+    a.emplace(&x);
+    CHECK_UNARY(a != b);
+    swap(a, b);
+    CHECK_EQ(a.error(), error_code::timed_out);
+    CHECK_EQ(*b, &x);
+
+    b.emplace_error(error_code::invalid);
+    CHECK_EQ(b.error(), error_code::invalid);
+
+    opt::option<res> c;
+    CHECK_UNARY_FALSE(c.has_value());
+    c.emplace(opt::in_place_error, error_code::not_found);
+    CHECK_UNARY(c.has_value());
+    CHECK_EQ(c->error(), error_code::not_found);
+    c.emplace(&x);
+    CHECK_EQ(**c, &x);
+}
+
+TEST_CASE("separate") {
+    using res = opt::result<std::string, std::string>;
+    CHECK_UNARY_FALSE(res::is_niche_packed);
+
+    res a{std::string(100, 'a')};
+    res b{opt::in_place_error, "error"};
+    CHECK_EQ(a->size(), 100);
+    CHECK_EQ(b.error(), "error");
+
+    a = b;
+    CHECK_EQ(a.error(), "error");
+    a = res{std::in_place, 3u, 'c'};
+    CHECK_EQ(*a, "ccc");
+    swap(a, b);
+    CHECK_EQ(a.error(), "error");
+    CHECK_EQ(*b, "ccc");
+
+    opt::result<std::unique_ptr<int>, int> c{std::make_unique<int>(2)};
+    opt::result<std::unique_ptr<int>, int> d{std::move(c)};
+    CHECK_EQ(**d, 2);
+    opt::option<std::unique_ptr<int>> e = std::move(d).ok();
+    CHECK_EQ(**e, 2);
+
+    opt::option<opt::result<int, error_code>> f;
+    CHECK_UNARY_FALSE(f.has_value());
+    f.emplace(5);
+    CHECK_EQ(**f, 5);
+    f.reset();
+    CHECK_UNARY_FALSE(f.has_value());
+}
+
+TEST_CASE("monadic") {
+    using res = opt::result<double, error_code>;
+    CHECK_UNARY(res::is_niche_packed);
+
+    const res a{2.0};
+    const res b{opt::in_place_error, error_code::invalid};
+
+    const auto c = a.map([](double x) { return int(x * 2); });
+    CHECK_EQ(*c, 4);
+    CHECK_EQ(b.map([](double x) { return int(x); }).error(), error_code::invalid);
+
+    const auto half = [](double x) {
+        return x > 1.0 ? res{x / 2} : res{opt::in_place_error, error_code::invalid};
+    };
+    CHECK_EQ(*a.and_then(half), 1.0);
+    CHECK_EQ(a.and_then(half).and_then(half).error(), error_code::invalid);
+    CHECK_EQ(b.and_then(half).error(), error_code::invalid);
+
+    const auto recover = [](error_code) { return res{0.0}; };
+    CHECK_EQ(*b.or_else(recover), 0.0);
+    CHECK_EQ(*a.or_else(recover), 2.0);
+
+    CHECK_EQ(b.map_error([](error_code e) { return int(e); }).error(), 2);
+    CHECK_EQ(b.value_or(1.0), 1.0);
+
+    const opt::option<double> d{3.0};
+    const res e{d, error_code::not_found};
+    CHECK_EQ(*e, 3.0);
+    const res f{opt::option<double>{}, error_code::not_found};
+    CHECK_EQ(f.error(), error_code::not_found);
+}
+
+TEST_SUITE_END();
+
+}
@@ -17,8 +17,14 @@
 #include <memory>
 #include <cstdint>
 #include <cstddef>
+#include <cstring>
 #include <variant>
+#include <optional>
+#include <chrono>
 #include <sstream>
+#if OPTION_IS_CXX20
+    #include <span>
+#endif
 
 #include "utils.hpp"
 
@@ -85,6 +91,16 @@ struct std::tuple_element<I, my_ns::my_tuple<T1, T2, T3>> {
     using type = std::conditional_t<I == 0, T1, std::conditional_t<I == 1, T2, T3>>;
 };
 
+#ifdef OPTION_HAS_PFR
+struct padded_struct_1 { std::uint64_t x; std::uint8_t y; };
+template<>
+struct opt::option_traits<padded_struct_1> : opt::padding_option_traits<padded_struct_1> {};
+
+struct padded_struct_2 { std::uint8_t x; std::uint64_t y; std::uint16_t z; };
+template<>
+struct opt::option_traits<padded_struct_2> : opt::padding_option_traits<padded_struct_2> {};
+#endif
+
 // NOLINTEND(cert-dcl58-cpp)
 
 namespace {
@@ -482,7 +498,8 @@ TEST_CASE("aggregate") {
 
         struct s3 { int x; long y; };
         const opt::option<s3> c{5, 10L};
-        CHECK(sizeof(c) > sizeof(s3));
+        // The padding bytes between the members are not used automatically
+        CHECK_GT(sizeof(c), sizeof(s3));
 
         struct s4 { float x; double y; };
         opt::option<s4> d{10.5f, 100.};
@@ -1571,6 +1588,64 @@ inline constexpr bool is_hashable = std::conjunction_v<
 >;
 
 // NOLINTBEGIN(misc-const-correctness)
+TEST_CASE("std::shared_ptr, std::weak_ptr") {
+    opt::option<std::shared_ptr<int>> a;
+    CHECK_EQ(sizeof(a), sizeof(std::shared_ptr<int>));
+    CHECK_UNARY_FALSE(a.has_value());
+    a = std::make_shared<int>(1);
+    CHECK_UNARY(a.has_value());
+    CHECK_EQ(**a, 1);
+    CHECK_EQ(a->use_count(), 1);
+
+    opt::option<std::weak_ptr<int>> b;
+    CHECK_EQ(sizeof(b), sizeof(std::weak_ptr<int>));
+    CHECK_UNARY_FALSE(b.has_value());
+    b = std::weak_ptr<int>{*a};
+    CHECK_UNARY(b.has_value());
+    CHECK_EQ(*(*b).lock(), 1);
+
+    a->reset();
+    CHECK_UNARY(a.has_value());
+    CHECK_EQ(*a, nullptr);
+    CHECK_UNARY(b.has_value());
+    CHECK_UNARY((*b).expired());
+    a.reset();
+    b.reset();
+    CHECK_UNARY_FALSE(a.has_value());
+    CHECK_UNARY_FALSE(b.has_value());
+
+    // Aliasing constructor with an empty owner: no control block, but a non-null stored pointer
+    int x = 2;
+    a.emplace(std::shared_ptr<int>{}, &x);
+    CHECK_UNARY(a.has_value());
+    CHECK_EQ(**a, 2);
+
+    opt::option<std::shared_ptr<int[]>> c{std::shared_ptr<int[]>{new int[2]{3, 4}}};
+    CHECK_EQ(sizeof(c), sizeof(std::shared_ptr<int[]>));
+    CHECK_EQ((*c)[1], 4);
+
+    using traits = opt::option_traits<std::shared_ptr<int>>;
+    std::shared_ptr<int> d;
+    CHECK_GE(traits::get_level(&d), traits::max_level);
+    traits::set_level(&d, 0);
+    CHECK_EQ(traits::get_level(&d), 0);
+    traits::set_level(&d, traits::max_level - 1);
+    CHECK_EQ(traits::get_level(&d), traits::max_level - 1);
+
+    // The level of an aliasing pointer without a control block comes from the stored pointer
+    const std::shared_ptr<int> e{std::shared_ptr<int>{}, &x};
+    CHECK_EQ(e.use_count(), 0);
+    CHECK_EQ(e.get(), &x);
+    CHECK_GE(traits::get_level(&e), traits::max_level);
+    const opt::option<std::shared_ptr<int>> f{e};
+    CHECK_UNARY(f.has_value());
+    CHECK_EQ(f->get(), &x);
+    const opt::option<opt::option<std::shared_ptr<int>>> g{f};
+    CHECK_UNARY(g.has_value());
+    CHECK_UNARY(g->has_value());
+    CHECK_EQ((*g)->get(), &x);
+}
+
 TEST_CASE("std::hash") {
     SUBCASE("non references") {
         opt::option<int> a;
@@ -1647,6 +1722,279 @@ TEST_CASE("std::string") {
     CHECK_UNARY(a.has_value());
 }
 
+TEST_CASE("std::optional") {
+    opt::option<std::optional<int>> a;
+    CHECK_EQ(sizeof(a), sizeof(std::optional<int>));
+    CHECK_UNARY_FALSE(a.has_value());
+    a.emplace();
+    CHECK_UNARY(a.has_value());
+    CHECK_UNARY_FALSE(a->has_value());
+    *a = 1;
+    CHECK_UNARY(a.has_value());
+    CHECK_EQ(**a, 1);
+    a.reset();
+    CHECK_UNARY_FALSE(a.has_value());
+
+    opt::option<opt::option<std::optional<std::string>>> b;
+    CHECK_EQ(sizeof(b), sizeof(std::optional<std::string>));
+    b = opt::option<std::optional<std::string>>{};
+    CHECK_UNARY(b.has_value());
+    CHECK_UNARY_FALSE(b->has_value());
+    b->emplace("abc");
+    CHECK_UNARY((*b)->has_value());
+    CHECK_EQ(***b, "abc");
+
+    using traits = opt::option_traits<std::optional<double>>;
+    std::optional<double> c{2.0};
+    CHECK_GE(traits::get_level(&c), traits::max_level);
+    traits::set_level(&c, 0);
+    CHECK_EQ(traits::get_level(&c), 0);
+    traits::set_level(&c, traits::max_level - 1);
+    CHECK_EQ(traits::get_level(&c), traits::max_level - 1);
+}
+
+#if OPTION_LIBSTDCPP || OPTION_LIBCPP
+TEST_CASE("std::variant") {
+    opt::option<std::variant<int, float, std::string>> a;
+    CHECK_EQ(sizeof(a), sizeof(std::variant<int, float, std::string>));
+    CHECK_UNARY_FALSE(a.has_value());
+    a.emplace(1);
+    CHECK_UNARY(a.has_value());
+    CHECK_EQ(a->index(), 0);
+    *a = 2.f;
+    CHECK_EQ(a->index(), 1);
+    *a = std::string(100, 'a');
+    CHECK_EQ(a->index(), 2);
+    CHECK_EQ(std::get<2>(*a).size(), 100);
+    a.reset();
+    CHECK_UNARY_FALSE(a.has_value());
+
+    opt::option<opt::option<std::variant<char, bool>>> b;
+    CHECK_EQ(sizeof(b), sizeof(std::variant<char, bool>));
+    b.emplace();
+    CHECK_UNARY(b.has_value());
+    CHECK_UNARY_FALSE(b->has_value());
+    b->emplace(true);
+    CHECK_EQ(std::get<bool>(**b), true);
+
+    using traits = opt::option_traits<std::variant<std::uint64_t, double>>;
+    std::variant<std::uint64_t, double> c{1.0};
+    CHECK_GE(traits::get_level(&c), traits::max_level);
+    traits::set_level(&c, 0);
+    CHECK_EQ(traits::get_level(&c), 0);
+    traits::set_level(&c, traits::max_level - 1);
+    CHECK_EQ(traits::get_level(&c), traits::max_level - 1);
+}
+#endif
+
+TEST_CASE("opt::from_std_optional, opt::to_std_optional") {
+    CHECK_EQ(opt::from_std_optional(std::optional<int>{1}), 1);
+    CHECK_EQ(opt::from_std_optional(std::optional<int>{}), opt::none);
+    CHECK_EQ(opt::to_std_optional(opt::option<int>{2}), std::optional<int>{2});
+    CHECK_EQ(opt::to_std_optional(opt::option<int>{}), std::nullopt);
+
+    CHECK_EQ(opt::from_std_optional(std::optional<float>{1.5f}), 1.5f);
+    CHECK_EQ(opt::from_std_optional(std::optional<float>{}), opt::none);
+    CHECK_EQ(opt::to_std_optional(opt::option<float>{2.5f}), std::optional<float>{2.5f});
+    CHECK_EQ(opt::to_std_optional(opt::option<float>{}), std::nullopt);
+
+    std::optional<std::string> a{"abc"};
+    const opt::option<std::string> b = opt::from_std_optional(a);
+    CHECK_EQ(b, "abc");
+    CHECK_EQ(opt::to_std_optional(b), a);
+    CHECK_EQ(opt::to_std_optional(opt::option<std::string>{}), std::nullopt);
+    CHECK_EQ(opt::from_std_optional(std::move(a)), "abc");
+}
+
+TEST_CASE("combined levels") {
+    using traits1 = opt::option_traits<std::pair<bool, bool>>;
+    CHECK_EQ(traits1::max_level, 254 * 254);
+    std::pair<bool, bool> a{true, false};
+    CHECK_GE(traits1::get_level(&a), traits1::max_level);
+    for (const std::uintmax_t level : {std::uintmax_t(0), std::uintmax_t(1), std::uintmax_t(253), std::uintmax_t(254), std::uintmax_t(1000), traits1::max_level - 1}) {
+        CAPTURE(level);
+        traits1::set_level(&a, level);
+        CHECK_EQ(traits1::get_level(&a), level);
+    }
+
+    using traits2 = opt::option_traits<std::tuple<bool, int, double, bool>>;
+    CHECK_EQ(traits2::max_level, 254 * 256 * 254);
+    std::tuple<bool, int, double, bool> b{false, 1, 2.0, true};
+    CHECK_GE(traits2::get_level(&b), traits2::max_level);
+    traits2::set_level(&b, 100000);
+    CHECK_EQ(traits2::get_level(&b), 100000);
+
+    using traits3 = opt::option_traits<std::array<bool, 3>>;
+    CHECK_EQ(traits3::max_level, 254 * 254 * 254);
+    using traits4 = opt::option_traits<std::array<bool, 100>>;
+    using traits5 = opt::option_traits<std::array<bool, 8>>;
+    CHECK_EQ(traits4::max_level, traits5::max_level);
+
+    // A single member with enough levels is used alone
+    using traits6 = opt::option_traits<std::pair<bool, char32_t>>;
+    CHECK_EQ(traits6::max_level, opt::option_traits<char32_t>::max_level);
+    using traits7 = opt::option_traits<std::pair<int, bool>>;
+    CHECK_EQ(traits7::max_level, 254);
+
+    opt::option<opt::option<opt::option<std::pair<bool, bool>>>> c;
+    CHECK_EQ(sizeof(c), sizeof(std::pair<bool, bool>));
+    CHECK_UNARY_FALSE(c.has_value());
+    c.emplace();
+    CHECK_UNARY(c.has_value());
+    CHECK_UNARY_FALSE(c->has_value());
+    c->emplace();
+    CHECK_UNARY(c->has_value());
+    CHECK_UNARY_FALSE((*c)->has_value());
+    (*c)->emplace(false, true);
+    CHECK_EQ(***c, std::pair{false, true});
+    c.reset();
+    CHECK_UNARY_FALSE(c.has_value());
+}
+
+#ifdef OPTION_HAS_PFR
+TEST_CASE("padding bytes") {
+    using s1 = padded_struct_1;
+    using traits1 = opt::option_traits<s1>;
+    CHECK_EQ(traits1::max_level, 256);
+
+    opt::option<s1> a;
+    CHECK_EQ(sizeof(a), sizeof(s1));
+    CHECK_UNARY_FALSE(a.has_value());
+    a.emplace(s1{1u, 2u});
+    CHECK_UNARY(a.has_value());
+    CHECK_EQ(a->x, 1u);
+    CHECK_EQ(a->y, 2u);
+    a.reset();
+    CHECK_UNARY_FALSE(a.has_value());
+    a = s1{3u, 4u};
+    CHECK_EQ(a->x, 3u);
+    const opt::option<s1> b = a;
+    CHECK_EQ(b->y, 4u);
+
+    using s2 = padded_struct_2;
+    opt::option<opt::option<s2>> c{opt::option<s2>{}};
+    CHECK_EQ(sizeof(c), sizeof(s2));
+    CHECK_UNARY(c.has_value());
+    CHECK_UNARY_FALSE(c->has_value());
+    c->emplace(s2{1u, 2u, 3u});
+    CHECK_EQ((*c)->z, 3u);
+    c.reset();
+    CHECK_UNARY_FALSE(c.has_value());
+
+    // A value whose padding bytes hold the empty state
+    const opt::option<s1> empty;
+    s1 stale{};
+    std::memcpy(static_cast<void*>(&stale), &empty, sizeof(s1));
+    stale.x = 5u;
+    stale.y = 6u;
+    CHECK_EQ(traits1::get_level(&stale), 0);
+
+    a = stale;
+    CHECK_UNARY(a.has_value());
+    CHECK_EQ(a->x, 5u);
+    a = opt::option<s1>{s1{7u, 8u}};
+    a = std::as_const(stale);
+    CHECK_UNARY(a.has_value());
+    CHECK_EQ(a->y, 6u);
+    opt::option<s1> d{stale};
+    CHECK_UNARY(d.has_value());
+    d.emplace(stale);
+    CHECK_UNARY(d.has_value());
+
+    std::memcpy(static_cast<void*>(&d.get()), &stale, sizeof(s1));
+    CHECK_UNARY_FALSE(d.has_value());
+    d = s1{9u, 10u};
+    CHECK_UNARY(d.has_value());
+    opt::option<s1> e{s1{1u, 1u}};
+    e = d;
+    CHECK_EQ(e->x, 9u);
+
+    // Never selected automatically
+    struct s3 { std::uint64_t x; std::uint8_t y; };
+    CHECK_EQ(opt::option_traits<s3>::max_level, 0);
+    CHECK_GT(sizeof(opt::option<s3>), sizeof(s3));
+    // The member levels are used
+    struct s4 { bool x; std::uint64_t y; };
+    CHECK_EQ(opt::option_traits<s4>::max_level, 254);
+}
+#endif
+
+TEST_CASE("char32_t") {
+    opt::option<char32_t> a;
+    CHECK_EQ(sizeof(a), sizeof(char32_t));
+    CHECK_UNARY_FALSE(a.has_value());
+    a = U'\0';
+    CHECK_EQ(a, U'\0');
+    a = char32_t(0x10FFFF);
+    CHECK_EQ(a, char32_t(0x10FFFF));
+
+    using traits = opt::option_traits<char32_t>;
+    CHECK_GT(traits::max_level, 0xFF000000u);
+    char32_t b = U'a';
+    CHECK_GE(traits::get_level(&b), traits::max_level);
+    traits::set_level(&b, 0);
+    CHECK_EQ(b, char32_t(0x110000));
+    CHECK_EQ(traits::get_level(&b), 0);
+    traits::set_level(&b, traits::max_level - 1);
+    CHECK_EQ(b, char32_t(0xFFFFFFFF));
+    CHECK_EQ(traits::get_level(&b), traits::max_level - 1);
+}
+
+TEST_CASE("std::chrono") {
+    using fp_seconds = std::chrono::duration<double>;
+    opt::option<fp_seconds> a;
+    CHECK_EQ(sizeof(a), sizeof(fp_seconds));
+    CHECK_UNARY_FALSE(a.has_value());
+    a = fp_seconds{1.5};
+    CHECK_EQ(a->count(), 1.5);
+
+    using fp_time_point = std::chrono::time_point<std::chrono::system_clock, fp_seconds>;
+    opt::option<fp_time_point> b;
+    CHECK_EQ(sizeof(b), sizeof(fp_time_point));
+    CHECK_UNARY_FALSE(b.has_value());
+    b = fp_time_point{fp_seconds{2.5}};
+    CHECK_EQ(b->time_since_epoch().count(), 2.5);
+
+#if OPTION_USE_CHRONO_MIN_SENTINEL
+    CHECK_EQ(sizeof(opt::option<std::chrono::seconds>), sizeof(std::chrono::seconds));
+    CHECK_EQ(sizeof(opt::option<std::chrono::system_clock::time_point>), sizeof(std::chrono::system_clock::time_point));
+#else
+    CHECK_GT(sizeof(opt::option<std::chrono::seconds>), sizeof(std::chrono::seconds));
+#endif
+    using min_traits = opt::impl::internal_option_traits<std::chrono::seconds, opt::impl::option_strategy::chrono_duration_min>;
+    std::chrono::seconds c{0};
+    CHECK_GE(min_traits::get_level(&c), min_traits::max_level);
+    c = std::chrono::seconds::max();
+    CHECK_GE(min_traits::get_level(&c), min_traits::max_level);
+    min_traits::set_level(&c, 0);
+    CHECK_EQ(c, std::chrono::seconds::min());
+    CHECK_EQ(min_traits::get_level(&c), 0);
+    min_traits::set_level(&c, min_traits::max_level - 1);
+    CHECK_EQ(min_traits::get_level(&c), min_traits::max_level - 1);
+}
+
+#if OPTION_IS_CXX20
+TEST_CASE("std::span") {
+    int arr[3]{1, 2, 3};
+    opt::option<std::span<int>> a;
+    CHECK_EQ(sizeof(a), sizeof(std::span<int>));
+    CHECK_UNARY_FALSE(a.has_value());
+    a = std::span<int>{arr};
+    CHECK_EQ(a->size(), 3);
+    a = std::span<int>{};
+    CHECK_UNARY(a.has_value());
+    CHECK_UNARY(a->empty());
+
+    opt::option<std::span<const int, 3>> b;
+    CHECK_EQ(sizeof(b), sizeof(std::span<const int, 3>));
+    CHECK_UNARY_FALSE(b.has_value());
+    b = std::span<const int, 3>{arr};
+    CHECK_EQ((*b)[2], 3);
+    b.reset();
+    CHECK_UNARY_FALSE(b.has_value());
+}
+#endif
+
 TEST_CASE("option<bool>") {
     const opt::option<bool> a{false};
     const opt::option<int> b{a};
@@ -1662,6 +2010,42 @@ TEST_CASE("option<bool>") {
     CHECK_EQ(d, false);
 }
 
+TEST_CASE("pointer") {
+    using traits = opt::option_traits<int*>;
+#if OPTION_USE_NONCANONICAL_POINTERS
+    #if defined(__aarch64__) || defined(_M_ARM64)
+    constexpr std::uintmax_t noncanonical_levels = 0xF8EF'FFFF'FFFF'FFFFull - 0xF8E1'B182'5D5D'6C67ull + 1;
+    #else
+    constexpr std::uintmax_t noncanonical_levels = 0xFEFF'FFFF'FFFF'FFFFull - 0xF8E1'B182'5D5D'6C67ull + 1;
+    #endif
+    CHECK_EQ(traits::max_level, sizeof(int*) == 8 ? noncanonical_levels : 32);
+#else
+    CHECK_EQ(traits::max_level, sizeof(int*) == 8 ? 512 : 32);
+#endif
+    int a = 1;
+    int* b = &a;
+    CHECK_GE(traits::get_level(&b), traits::max_level);
+    b = nullptr;
+    CHECK_GE(traits::get_level(&b), traits::max_level);
+
+    traits::set_level(&b, traits::max_level - 1);
+    CHECK_EQ(traits::get_level(&b), traits::max_level - 1);
+    traits::set_level(&b, 0);
+    CHECK_EQ(traits::get_level(&b), 0);
+    if (sizeof(int*) == 8) {
+        std::uint64_t bits{};
+        std::memcpy(&bits, &b, sizeof(bits));
+        CHECK_EQ(bits, 0xF8E1'B182'5D5D'6C67ull);
+    }
+
+    // The empty state is the same for any `max_level`
+    const opt::option<int*> c;
+    const opt::option<opt::option<opt::option<int*>>> d;
+    CHECK_EQ(sizeof(c), sizeof(int*));
+    CHECK_EQ(sizeof(d), sizeof(int*));
+    CHECK_UNARY_FALSE(d.has_value());
+}
+
 TEST_CASE("internal invoke") {
     const opt::option<int> a = opt::option<int>{1}.map([](int x) { return x + 1; });
     CHECK_EQ(a, 2);
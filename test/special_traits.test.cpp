@@ -5,6 +5,8 @@
 
 #include <doctest/doctest.h>
 #include <opt/option.hpp>
+#include <limits>
+#include <cstdint>
 
 #include "utils.hpp"
 
@@ -17,6 +19,17 @@ struct opt::sentinel_option_traits<my_type1> {
     static constexpr my_type1 sentinel_value{1};
 };
 
+enum class my_enum1 : std::uint16_t { a, b, c, d = 1000 };
+template<>
+struct opt::enumeration_option_traits<my_enum1> {
+    static constexpr my_enum1 max_value = my_enum1::d;
+};
+enum my_enum2 : std::uint8_t { my_enum2_a, my_enum2_b };
+template<>
+struct opt::enumeration_option_traits<my_enum2> {
+    static constexpr my_enum2 max_value = my_enum2_b;
+};
+
 namespace {
 
 TEST_SUITE_BEGIN("opt::sentinel");
@@ -148,6 +161,55 @@ TEST_CASE("pointer") {
     }
 }
 
+TEST_CASE("many values") {
+    // Consecutive values
+    using consecutive = opt::sentinel<std::uint16_t, 500, 501, 502, 503, 504, 505, 506, 507, 508, 509>;
+    using traits1 = opt::option_traits<consecutive>;
+    CHECK_EQ(traits1::max_level, 10);
+    for (std::uintmax_t level = 0; level < traits1::max_level; ++level) {
+        consecutive value{};
+        traits1::set_level(&value, level);
+        CHECK_EQ(value.m, 500 + level);
+        CHECK_EQ(traits1::get_level(&value), level);
+    }
+    for (const std::uint16_t x : {std::uint16_t(0), std::uint16_t(499), std::uint16_t(510), std::uint16_t(65535)}) {
+        const consecutive value{x};
+        CHECK_GE(traits1::get_level(&value), traits1::max_level);
+    }
+
+    // Values close to each other (including negative ones and duplicates)
+    using codes = opt::sentinel<int, 104, -1, 200, 103, 118, -1, 151, 203>;
+    using traits2 = opt::option_traits<codes>;
+    const int values[]{104, -1, 200, 103, 118, -1, 151, 203};
+    for (std::uintmax_t level = 0; level < traits2::max_level; ++level) {
+        codes value{};
+        traits2::set_level(&value, level);
+        CHECK_EQ(value.m, values[level]);
+        CHECK_EQ(traits2::get_level(&value), level == 5 ? 1 : level);
+    }
+    for (const int x : {-2, 0, 102, 105, 202, 204, 404, std::numeric_limits<int>::min()}) {
+        const codes value{x};
+        CHECK_GE(traits2::get_level(&value), traits2::max_level);
+    }
+
+    // Values far from each other
+    using far = opt::sentinel<std::int64_t, 0, 1000000, -1000000>;
+    using traits3 = opt::option_traits<far>;
+    far c{};
+    traits3::set_level(&c, 2);
+    CHECK_EQ(c.m, -1000000);
+    CHECK_EQ(traits3::get_level(&c), 2);
+
+    enum class code : std::uint8_t { ok, error1 = 200, error2, error3 };
+    opt::option<opt::option<opt::sentinel<code, code::error1, code::error2, code::error3>>> d;
+    CHECK_EQ(sizeof(d), 1);
+    CHECK_UNARY_FALSE(d.has_value());
+    d.emplace();
+    CHECK_UNARY_FALSE(d->has_value());
+    d->emplace(code::ok);
+    CHECK_EQ((*d)->m, code::ok);
+}
+
 TEST_SUITE_END();
 
 TEST_CASE("opt::member") {
@@ -188,6 +250,56 @@ TEST_CASE("opt::sentinel_f") {
     CHECK_EQ(a, opt::none);
     a.reset();
     CHECK_EQ(a, opt::none);
+
+    opt::option<opt::option<opt::sentinel_f<int, compare, set, -1, -3>>> b;
+    CHECK_EQ(sizeof(b), sizeof(int));
+    CHECK_UNARY_FALSE(b.has_value());
+    b.emplace();
+    CHECK_UNARY(b.has_value());
+    CHECK_UNARY_FALSE(b->has_value());
+    b->emplace(5);
+    CHECK_EQ(*b, 5);
+}
+
+TEST_CASE("opt::bounded") {
+    using port = opt::bounded<std::int32_t, 0, std::numeric_limits<std::int32_t>::max()>;
+    CHECK_EQ(sizeof(opt::option<port>), sizeof(std::int32_t));
+    CHECK_EQ(sizeof(opt::option<opt::option<opt::option<port>>>), sizeof(std::int32_t));
+    CHECK_EQ(opt::option_traits<port>::max_level, std::uintmax_t(1) << 31);
+
+    opt::option<port> a;
+    CHECK_UNARY_FALSE(a.has_value());
+    a = 0;
+    CHECK_EQ(a->m, 0);
+    a = std::numeric_limits<std::int32_t>::max();
+    CHECK_EQ(a->m, std::numeric_limits<std::int32_t>::max());
+    a.reset();
+    CHECK_UNARY_FALSE(a.has_value());
+
+    using status = opt::bounded<std::uint16_t, 100, 999>;
+    using traits = opt::option_traits<status>;
+    CHECK_EQ(traits::max_level, 65536 - 900);
+    for (const std::uint16_t x : {std::uint16_t(100), std::uint16_t(500), std::uint16_t(999)}) {
+        const status value{x};
+        CHECK_GE(traits::get_level(&value), traits::max_level);
+    }
+    status b{};
+    traits::set_level(&b, 0);
+    CHECK_EQ(b.m, 1000);
+    CHECK_EQ(traits::get_level(&b), 0);
+    traits::set_level(&b, traits::max_level - 1);
+    CHECK_EQ(b.m, 99);
+    CHECK_EQ(traits::get_level(&b), traits::max_level - 1);
+
+    using small = opt::bounded<std::int8_t, -10, 10>;
+    opt::option<opt::option<small>> c;
+    CHECK_EQ(sizeof(c), 1);
+    CHECK_UNARY_FALSE(c.has_value());
+    c.emplace();
+    CHECK_UNARY(c.has_value());
+    CHECK_UNARY_FALSE(c->has_value());
+    c->emplace(std::int8_t(-10));
+    CHECK_EQ((*c)->m, -10);
 }
 
 TEST_CASE("opt::sentinel_option_traits") {
@@ -207,4 +319,37 @@ TEST_CASE("opt::sentinel_option_traits") {
     CHECK_UNARY_FALSE(a.has_value());
 }
 
+TEST_CASE("opt::enumeration_option_traits") {
+    using traits1 = opt::option_traits<my_enum1>;
+    CHECK_EQ(traits1::max_level, 65535 - 1000);
+
+    opt::option<my_enum1> a;
+    CHECK_EQ(sizeof(a), sizeof(my_enum1));
+    CHECK_UNARY_FALSE(a.has_value());
+    a = my_enum1::d;
+    CHECK_EQ(a, my_enum1::d);
+    a = my_enum1::a;
+    CHECK_EQ(a, my_enum1::a);
+    a.reset();
+    CHECK_UNARY_FALSE(a.has_value());
+
+    my_enum1 b{};
+    traits1::set_level(&b, 0);
+    CHECK_EQ(std::uint16_t(b), 1001);
+    CHECK_EQ(traits1::get_level(&b), 0);
+    traits1::set_level(&b, traits1::max_level - 1);
+    CHECK_EQ(std::uint16_t(b), 65535);
+    CHECK_EQ(traits1::get_level(&b), traits1::max_level - 1);
+
+    using traits2 = opt::option_traits<my_enum2>;
+    CHECK_EQ(traits2::max_level, 254);
+    opt::option<opt::option<my_enum2>> c;
+    CHECK_EQ(sizeof(c), 1);
+    CHECK_UNARY_FALSE(c.has_value());
+    c.emplace();
+    CHECK_UNARY_FALSE(c->has_value());
+    c->emplace(my_enum2_b);
+    CHECK_EQ(**c, my_enum2_b);
+}
+
 }